@@ -0,0 +1,27 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef VSOMEIP_CFG_APPLICATION_HPP
+#define VSOMEIP_CFG_APPLICATION_HPP
+
+#include <cstddef>
+
+#include <vsomeip/primitive_types.hpp>
+
+namespace vsomeip {
+namespace cfg {
+
+struct application {
+    client_t id_;
+    std::size_t num_dispatchers_;
+    bool is_local_shm_enabled_;
+    bool is_ordered_dispatch_;
+    std::size_t num_io_threads_;
+};
+
+} // namespace cfg
+} // namespace vsomeip
+
+#endif // VSOMEIP_CFG_APPLICATION_HPP
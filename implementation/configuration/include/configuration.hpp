@@ -58,11 +58,30 @@ public:
             uint16_t _port) const = 0;
     virtual uint16_t get_unreliable_port(service_t _service,
             instance_t _instance) const = 0;
+    virtual uint32_t get_max_flush_delay(service_t _service,
+            instance_t _instance) const = 0;
+    virtual uint32_t get_max_flush_bytes(service_t _service,
+            instance_t _instance) const = 0;
+    virtual uint32_t get_max_tp_segment_length(service_t _service,
+            instance_t _instance) const = 0;
+    virtual uint32_t get_max_tp_message_size(service_t _service,
+            instance_t _instance) const = 0;
+    virtual uint32_t get_tp_timeout(service_t _service,
+            instance_t _instance) const = 0;
 
     virtual std::set<std::pair<service_t, instance_t> > get_remote_services() const = 0;
 
     virtual client_t get_id(const std::string &_name) const = 0;
     virtual std::size_t get_num_dispatchers(const std::string &_name) const = 0;
+    virtual bool is_local_shm_enabled(const std::string &_name) const = 0;
+    virtual bool is_ordered_dispatch(const std::string &_name) const = 0;
+    virtual std::size_t get_num_io_threads(const std::string &_name) const = 0;
+
+    virtual bool is_message_pool_enabled() const = 0;
+    virtual std::size_t get_message_pool_size() const = 0;
+
+    virtual bool is_io_uring_enabled() const = 0;
+    virtual std::uint32_t get_io_uring_buffers() const = 0;
 
     virtual std::uint32_t get_max_message_size_local() const = 0;
     virtual std::uint32_t get_message_size_reliable(const std::string& _address,
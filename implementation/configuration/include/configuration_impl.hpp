@@ -13,6 +13,7 @@
 
 #include <boost/property_tree/ptree.hpp>
 
+#include "application.hpp"
 #include "configuration.hpp"
 
 namespace vsomeip {
@@ -56,6 +57,16 @@ public:
     VSOMEIP_EXPORT bool has_enabled_magic_cookies(std::string _address, uint16_t _port) const;
     VSOMEIP_EXPORT uint16_t get_unreliable_port(service_t _service,
             instance_t _instance) const;
+    VSOMEIP_EXPORT uint32_t get_max_flush_delay(service_t _service,
+            instance_t _instance) const;
+    VSOMEIP_EXPORT uint32_t get_max_flush_bytes(service_t _service,
+            instance_t _instance) const;
+    VSOMEIP_EXPORT uint32_t get_max_tp_segment_length(service_t _service,
+            instance_t _instance) const;
+    VSOMEIP_EXPORT uint32_t get_max_tp_message_size(service_t _service,
+            instance_t _instance) const;
+    VSOMEIP_EXPORT uint32_t get_tp_timeout(service_t _service,
+            instance_t _instance) const;
 
     VSOMEIP_EXPORT bool is_someip(service_t _service, instance_t _instance) const;
 
@@ -63,9 +74,18 @@ public:
 
     VSOMEIP_EXPORT client_t get_id(const std::string &_name) const;
     VSOMEIP_EXPORT std::size_t get_num_dispatchers(const std::string &_name) const;
+    VSOMEIP_EXPORT bool is_local_shm_enabled(const std::string &_name) const;
+    VSOMEIP_EXPORT bool is_ordered_dispatch(const std::string &_name) const;
+    VSOMEIP_EXPORT std::size_t get_num_io_threads(const std::string &_name) const;
 
     VSOMEIP_EXPORT std::set<std::pair<service_t, instance_t> > get_remote_services() const;
 
+    VSOMEIP_EXPORT bool is_message_pool_enabled() const;
+    VSOMEIP_EXPORT std::size_t get_message_pool_size() const;
+
+    VSOMEIP_EXPORT bool is_io_uring_enabled() const;
+    VSOMEIP_EXPORT std::uint32_t get_io_uring_buffers() const;
+
     VSOMEIP_EXPORT std::uint32_t get_max_message_size_local() const;
     VSOMEIP_EXPORT std::uint32_t get_message_size_reliable(const std::string& _address,
                                            std::uint16_t _port) const;
@@ -95,6 +115,8 @@ private:
     void get_service_discovery_configuration(
             const boost::property_tree::ptree &_tree);
     void get_applications_configuration(const boost::property_tree::ptree &_tree);
+    void get_message_pool_configuration(const boost::property_tree::ptree &_tree);
+    void get_io_uring_configuration(const boost::property_tree::ptree &_tree);
 
     void get_servicegroup_configuration(
             const boost::property_tree::ptree &_tree);
@@ -125,7 +147,7 @@ protected:
     std::string logfile_;
     boost::log::trivial::severity_level loglevel_;
 
-    std::map<std::string, std::pair<client_t, std::size_t>> applications_;
+    std::map<std::string, application> applications_;
 
     std::map<service_t,
         std::map<instance_t,
@@ -146,6 +168,12 @@ protected:
     int32_t sd_cyclic_offer_delay_;
     int32_t sd_request_response_delay_;
 
+    bool is_message_pool_enabled_;
+    std::size_t message_pool_size_;
+
+    bool is_io_uring_enabled_;
+    std::uint32_t io_uring_buffers_;
+
     std::map<std::string, std::set<uint16_t> > magic_cookies_;
 
     std::map<std::string, std::map<std::uint16_t, std::uint32_t>> message_sizes_;
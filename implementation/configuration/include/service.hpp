@@ -31,6 +31,13 @@ struct service {
 
     std::string protocol_;
 
+    uint32_t max_flush_delay_;
+    uint32_t max_flush_bytes_;
+
+    uint32_t max_tp_segment_length_;
+    uint32_t max_tp_message_size_;
+    uint32_t tp_timeout_;
+
     std::shared_ptr<servicegroup> group_;
     std::map<event_t, std::shared_ptr<event> > events_;
     std::map<eventgroup_t, std::shared_ptr<eventgroup> > eventgroups_;
@@ -107,6 +107,10 @@ configuration_impl::configuration_impl() :
         sd_ttl_(VSOMEIP_SD_DEFAULT_TTL),
         sd_cyclic_offer_delay_(VSOMEIP_SD_DEFAULT_CYCLIC_OFFER_DELAY),
         sd_request_response_delay_(VSOMEIP_SD_DEFAULT_REQUEST_RESPONSE_DELAY),
+        is_message_pool_enabled_(false),
+        message_pool_size_(VSOMEIP_DEFAULT_MESSAGE_POOL_SIZE),
+        is_io_uring_enabled_(false),
+        io_uring_buffers_(VSOMEIP_DEFAULT_IO_URING_BUFFERS),
         max_configured_message_size_(0) {
 
     unicast_ = unicast_.from_string(VSOMEIP_UNICAST_ADDRESS);
@@ -142,6 +146,12 @@ configuration_impl::configuration_impl(const configuration_impl &_other) :
     sd_cyclic_offer_delay_= _other.sd_cyclic_offer_delay_;
     sd_request_response_delay_= _other.sd_request_response_delay_;
 
+    is_message_pool_enabled_ = _other.is_message_pool_enabled_;
+    message_pool_size_ = _other.message_pool_size_;
+
+    is_io_uring_enabled_ = _other.is_io_uring_enabled_;
+    io_uring_buffers_ = _other.io_uring_buffers_;
+
     magic_cookies_.insert(_other.magic_cookies_.begin(), _other.magic_cookies_.end());
 }
 
@@ -157,6 +167,8 @@ void configuration_impl::load(const boost::property_tree::ptree &_tree) {
         get_routing_configuration(_tree);
         get_service_discovery_configuration(_tree);
         get_applications_configuration(_tree);
+        get_message_pool_configuration(_tree);
+        get_io_uring_configuration(_tree);
     } catch (std::exception &e) {
     }
 }
@@ -366,6 +378,12 @@ void configuration_impl::get_service_configuration(
         its_service->multicast_port_ = ILLEGAL_PORT;
         its_service->multicast_group_ = 0xFFFF;  // TODO: use symbolic constant
         its_service->protocol_ = "someip";
+        its_service->max_flush_delay_ = VSOMEIP_DEFAULT_FLUSH_TIMEOUT;
+        its_service->max_flush_bytes_ = 0;
+        its_service->max_tp_segment_length_
+            = VSOMEIP_DEFAULT_TP_MAX_SEGMENT_LENGTH;
+        its_service->max_tp_message_size_ = 0;
+        its_service->tp_timeout_ = VSOMEIP_DEFAULT_TP_TIMEOUT;
 
         for (auto i = _tree.begin(); i != _tree.end(); ++i) {
             std::string its_key(i->first);
@@ -404,6 +422,46 @@ void configuration_impl::get_service_configuration(
                 }
             } else if (its_key == "protocol") {
                 its_service->protocol_ = its_value;
+            } else if (its_key == "flush") {
+                try {
+                    its_value = i->second.get_child("max-delay").data();
+                    its_converter << its_value;
+                    its_converter >> its_service->max_flush_delay_;
+                } catch (...) {
+                }
+                try {
+                    its_value = i->second.get_child("max-bytes").data();
+                    its_converter.str("");
+                    its_converter.clear();
+                    its_converter << its_value;
+                    its_converter >> its_service->max_flush_bytes_;
+                } catch (...) {
+                }
+            } else if (its_key == "someip-tp") {
+                its_service->max_tp_message_size_
+                    = VSOMEIP_MAX_LOCAL_MESSAGE_SIZE;
+                try {
+                    its_value = i->second.get_child("max-segment-length").data();
+                    its_converter << its_value;
+                    its_converter >> its_service->max_tp_segment_length_;
+                } catch (...) {
+                }
+                try {
+                    its_value = i->second.get_child("max-message-size").data();
+                    its_converter.str("");
+                    its_converter.clear();
+                    its_converter << its_value;
+                    its_converter >> its_service->max_tp_message_size_;
+                } catch (...) {
+                }
+                try {
+                    its_value = i->second.get_child("timeout").data();
+                    its_converter.str("");
+                    its_converter.clear();
+                    its_converter << its_value;
+                    its_converter >> its_service->tp_timeout_;
+                } catch (...) {
+                }
             } else if (its_key == "events") {
                 get_event_configuration(its_service, i->second);
             } else if (its_key == "eventgroups") {
@@ -615,11 +673,53 @@ void configuration_impl::get_applications_configuration(
     }
 }
 
+void configuration_impl::get_message_pool_configuration(
+        const boost::property_tree::ptree &_tree) {
+    try {
+        auto its_message_pool = _tree.get_child("message-pool");
+        for (auto i = its_message_pool.begin();
+                i != its_message_pool.end(); ++i) {
+            std::string its_key(i->first);
+            std::string its_value(i->second.data());
+            std::stringstream its_converter;
+            if (its_key == "enable") {
+                is_message_pool_enabled_ = (its_value == "true");
+            } else if (its_key == "size") {
+                its_converter << its_value;
+                its_converter >> message_pool_size_;
+            }
+        }
+    } catch (...) {
+    }
+}
+
+void configuration_impl::get_io_uring_configuration(
+        const boost::property_tree::ptree &_tree) {
+    try {
+        auto its_io_uring = _tree.get_child("io-uring");
+        for (auto i = its_io_uring.begin(); i != its_io_uring.end(); ++i) {
+            std::string its_key(i->first);
+            std::string its_value(i->second.data());
+            std::stringstream its_converter;
+            if (its_key == "enable") {
+                is_io_uring_enabled_ = (its_value == "true");
+            } else if (its_key == "buffers") {
+                its_converter << its_value;
+                its_converter >> io_uring_buffers_;
+            }
+        }
+    } catch (...) {
+    }
+}
+
 void configuration_impl::get_application_configuration(
         const boost::property_tree::ptree &_tree) {
     std::string its_name("");
     client_t its_id;
     std::size_t its_num_dispatchers(0);
+    bool is_local_shm_enabled(false);
+    bool is_ordered_dispatch(false);
+    std::size_t its_num_io_threads(1);
     for (auto i = _tree.begin(); i != _tree.end(); ++i) {
         std::string its_key(i->first);
         std::string its_value(i->second.data());
@@ -640,10 +740,21 @@ void configuration_impl::get_application_configuration(
                 its_converter << std::dec << its_value;
             }
             its_converter >> its_num_dispatchers;
+        } else if (its_key == "local_transport") {
+            is_local_shm_enabled = (its_value == "shm");
+        } else if (its_key == "dispatch_order") {
+            is_ordered_dispatch = (its_value == "service");
+        } else if (its_key == "num_io_threads") {
+            its_converter << std::dec << its_value;
+            its_converter >> its_num_io_threads;
+            if (its_num_io_threads == 0)
+                its_num_io_threads = 1;
         }
     }
     if (its_name != "" && its_id != 0) {
-        applications_[its_name] = {its_id, its_num_dispatchers};
+        applications_[its_name]
+            = { its_id, its_num_dispatchers, is_local_shm_enabled,
+                is_ordered_dispatch, its_num_io_threads };
     }
 }
 
@@ -764,6 +875,61 @@ uint16_t configuration_impl::get_unreliable_port(service_t _service,
     return its_unreliable;
 }
 
+uint32_t configuration_impl::get_max_flush_delay(service_t _service,
+        instance_t _instance) const {
+    uint32_t its_max_delay = VSOMEIP_DEFAULT_FLUSH_TIMEOUT;
+
+    service *its_service = find_service(_service, _instance);
+    if (its_service)
+        its_max_delay = its_service->max_flush_delay_;
+
+    return its_max_delay;
+}
+
+uint32_t configuration_impl::get_max_flush_bytes(service_t _service,
+        instance_t _instance) const {
+    uint32_t its_max_bytes = 0;
+
+    service *its_service = find_service(_service, _instance);
+    if (its_service)
+        its_max_bytes = its_service->max_flush_bytes_;
+
+    return its_max_bytes;
+}
+
+uint32_t configuration_impl::get_max_tp_segment_length(service_t _service,
+        instance_t _instance) const {
+    uint32_t its_max_segment_length = VSOMEIP_DEFAULT_TP_MAX_SEGMENT_LENGTH;
+
+    service *its_service = find_service(_service, _instance);
+    if (its_service)
+        its_max_segment_length = its_service->max_tp_segment_length_;
+
+    return its_max_segment_length;
+}
+
+uint32_t configuration_impl::get_max_tp_message_size(service_t _service,
+        instance_t _instance) const {
+    uint32_t its_max_message_size = 0;
+
+    service *its_service = find_service(_service, _instance);
+    if (its_service)
+        its_max_message_size = its_service->max_tp_message_size_;
+
+    return its_max_message_size;
+}
+
+uint32_t configuration_impl::get_tp_timeout(service_t _service,
+        instance_t _instance) const {
+    uint32_t its_timeout = VSOMEIP_DEFAULT_TP_TIMEOUT;
+
+    service *its_service = find_service(_service, _instance);
+    if (its_service)
+        its_timeout = its_service->tp_timeout_;
+
+    return its_timeout;
+}
+
 const std::string & configuration_impl::get_routing_host() const {
     return routing_host_;
 }
@@ -773,7 +939,7 @@ client_t configuration_impl::get_id(const std::string &_name) const {
 
     auto found_application = applications_.find(_name);
     if (found_application != applications_.end()) {
-        its_client = found_application->second.first;
+        its_client = found_application->second.id_;
     }
 
     return its_client;
@@ -785,12 +951,62 @@ std::size_t configuration_impl::get_num_dispatchers(
 
     auto found_application = applications_.find(_name);
     if (found_application != applications_.end()) {
-        its_num_dispatchers = found_application->second.second;
+        its_num_dispatchers = found_application->second.num_dispatchers_;
     }
 
     return its_num_dispatchers;
 }
 
+bool configuration_impl::is_local_shm_enabled(const std::string &_name) const {
+    bool is_enabled(false);
+
+    auto found_application = applications_.find(_name);
+    if (found_application != applications_.end()) {
+        is_enabled = found_application->second.is_local_shm_enabled_;
+    }
+
+    return is_enabled;
+}
+
+bool configuration_impl::is_ordered_dispatch(const std::string &_name) const {
+    bool is_ordered(false);
+
+    auto found_application = applications_.find(_name);
+    if (found_application != applications_.end()) {
+        is_ordered = found_application->second.is_ordered_dispatch_;
+    }
+
+    return is_ordered;
+}
+
+std::size_t configuration_impl::get_num_io_threads(
+        const std::string &_name) const {
+    std::size_t its_num_io_threads = 1;
+
+    auto found_application = applications_.find(_name);
+    if (found_application != applications_.end()) {
+        its_num_io_threads = found_application->second.num_io_threads_;
+    }
+
+    return its_num_io_threads;
+}
+
+bool configuration_impl::is_message_pool_enabled() const {
+    return is_message_pool_enabled_;
+}
+
+std::size_t configuration_impl::get_message_pool_size() const {
+    return message_pool_size_;
+}
+
+bool configuration_impl::is_io_uring_enabled() const {
+    return is_io_uring_enabled_;
+}
+
+std::uint32_t configuration_impl::get_io_uring_buffers() const {
+    return io_uring_buffers_;
+}
+
 std::set<std::pair<service_t, instance_t> >
 configuration_impl::get_remote_services() const {
     std::set<std::pair<service_t, instance_t> > its_remote_services;
@@ -8,6 +8,7 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
 #include <vsomeip/defines.hpp>
 #include <vsomeip/primitive_types.hpp>
@@ -37,9 +37,13 @@ public:
             std::uint32_t _max_message_size);
     virtual ~client_endpoint_impl();
 
-    bool send(const uint8_t *_data, uint32_t _size, bool _flush);bool send_to(
-            const std::shared_ptr<endpoint_definition> _target,
-            const byte_t *_data, uint32_t _size, bool _flush = true);bool flush();
+    bool send(const uint8_t *_data, uint32_t _size, bool _flush);
+    bool send(const message_buffer_ptr_t &_buffer, bool _flush);
+    bool send_to(const std::shared_ptr<endpoint_definition> _target,
+            const byte_t *_data, uint32_t _size, bool _flush = true);
+    bool send_to(const std::shared_ptr<endpoint_definition> _target,
+            const message_buffer_ptr_t &_buffer, bool _flush = true);
+    bool flush();
 
     void stop();
     void restart();
@@ -10,6 +10,8 @@
 
 #include <vsomeip/primitive_types.hpp>
 
+#include "buffer.hpp"
+
 namespace vsomeip {
 
 class endpoint_definition;
@@ -27,6 +29,16 @@ public:
             bool _flush = true) = 0;
     virtual bool send_to(const std::shared_ptr<endpoint_definition> _target,
             const byte_t *_data, uint32_t _size, bool _flush = true) = 0;
+
+    // Buffers passed to these methods may be shared between several
+    // endpoints and therefore must not be modified after sending.
+    virtual bool send(const message_buffer_ptr_t &_buffer,
+            bool _flush = true) = 0;
+    virtual bool send_to(const std::shared_ptr<endpoint_definition> _target,
+            const message_buffer_ptr_t &_buffer, bool _flush = true) = 0;
+    virtual bool send_to(
+            const std::vector<std::shared_ptr<endpoint_definition> > &_targets,
+            const message_buffer_ptr_t &_buffer) = 0;
     virtual void enable_magic_cookies() = 0;
     virtual void receive() = 0;
 
@@ -37,6 +49,12 @@ public:
             const std::string &_address, uint16_t _port) = 0;
     virtual void remove_multicast(service_t _service, event_t _event) = 0;
 
+    virtual void set_flush_policy(service_t _service, std::uint32_t _max_delay,
+            std::uint32_t _max_bytes) = 0;
+    virtual void set_tp_policy(service_t _service,
+            std::uint32_t _max_segment_length, std::uint32_t _max_message_size,
+            std::uint32_t _timeout) = 0;
+
     virtual bool get_remote_address(boost::asio::ip::address &_address) const = 0;
     virtual unsigned short get_local_port() const = 0;
     virtual unsigned short get_remote_port() const = 0;
@@ -6,8 +6,11 @@
 #ifndef VSOMEIP_ENDPOINT_DEFINITION_HPP
 #define VSOMEIP_ENDPOINT_DEFINITION_HPP
 
-#include <map>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include <boost/asio/ip/address.hpp>
 
@@ -36,16 +39,50 @@ public:
     VSOMEIP_EXPORT endpoint_definition(
             const boost::asio::ip::address &_address,
             uint16_t _port, bool _is_reliable);
+
 private:
+    struct key {
+        boost::asio::ip::address address_;
+        uint16_t port_;
+        bool is_reliable_;
+
+        bool operator==(const key &_other) const {
+            return (port_ == _other.port_
+                    && is_reliable_ == _other.is_reliable_
+                    && address_ == _other.address_);
+        }
+    };
+
+    struct key_hash {
+        std::size_t operator()(const key &_key) const;
+    };
+
+    // Definitions are interned as long as they are used. The published
+    // table is never modified in place, so lookups only load it and do not
+    // wait for insertions (the atomic load of a shared_ptr may still take a
+    // short internal lock). New
+    // definitions are collected in added_ under the mutex and merged into
+    // a new table (dropping the unused definitions) once added_ has grown
+    // as large as the published table.
+    typedef std::unordered_map<key, std::weak_ptr<endpoint_definition>,
+            key_hash> definitions_t;
+
+    static std::shared_ptr<endpoint_definition> find(
+            const definitions_t &_definitions, const key &_key);
+    static void publish();
+
     boost::asio::ip::address address_;
     uint16_t port_;
     uint16_t remote_port_;
     bool is_reliable_;
 
-    static std::map<boost::asio::ip::address,
-        std::map<uint16_t,
-            std::map<bool,
-                     std::shared_ptr<endpoint_definition> > > > definitions_;
+    static std::shared_ptr<const definitions_t> definitions_;
+    static std::mutex definitions_mutex_;
+    static definitions_t added_;
+    // Keeps the most recently created definitions alive, so that short-lived
+    // definitions are found again instead of being recreated on each call.
+    static std::vector<std::shared_ptr<endpoint_definition> > recent_;
+    static std::size_t recent_position_;
 };
 
 } // namespace vsomeip
@@ -8,6 +8,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/system_timer.hpp>
@@ -29,6 +30,12 @@ public:
 
     void enable_magic_cookies();
 
+    // Sends the buffer to each of the targets separately
+    using endpoint::send_to;
+    bool send_to(
+            const std::vector<std::shared_ptr<endpoint_definition> > &_targets,
+            const message_buffer_ptr_t &_buffer);
+
     // Dummy implementations as we only need these for UDP (servers)
     // TODO: redesign
     void join(const std::string &);
@@ -36,6 +43,14 @@ public:
     void add_multicast(service_t, event_t, const std::string &, uint16_t);
     void remove_multicast(service_t, event_t);
 
+    // Dummy implementation as we only need this for server endpoints
+    // TODO: redesign
+    void set_flush_policy(service_t, std::uint32_t, std::uint32_t);
+
+    // Dummy implementation as we only need this for UDP endpoints
+    // TODO: redesign
+    void set_tp_policy(service_t, std::uint32_t, std::uint32_t, std::uint32_t);
+
     // Dummy implementation as we only need this for IP client endpoints
     // TODO: redesign
     bool get_remote_address(boost::asio::ip::address &_address) const;
@@ -60,6 +75,12 @@ protected:
     virtual bool is_magic_cookie() const;
     uint32_t find_magic_cookie(byte_t *_buffer, size_t _size);
 
+    // Packet buffers are reused after they have been sent. Callers must
+    // hold the mutex_ of the client or server endpoint, which also
+    // protects the send queue(s).
+    message_buffer_ptr_t create_packetizer();
+    void recycle_packetizer(const message_buffer_ptr_t &_buffer);
+
 protected:
     // Reference to service context
     boost::asio::io_service &service_;
@@ -75,6 +96,8 @@ protected:
 
     std::uint32_t max_message_size_;
 
+    std::vector<message_buffer_ptr_t> spare_packetizers_;
+
     uint32_t use_count_;
 };
 
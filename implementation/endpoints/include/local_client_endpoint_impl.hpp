@@ -40,24 +40,19 @@ public:
 
     bool is_local() const;
 
-private:
+protected:
     void send_queued();
 
-    void send_start_tag();
-    void send_queued_data();
-    void send_end_tag();
-
     void send_magic_cookie();
 
     void connect();
     void receive();
 
-    void send_start_tag_cbk(boost::system::error_code const &_error,
-                            std::size_t _bytes);
-    void send_queued_data_cbk(boost::system::error_code const &_error,
-                              std::size_t _bytes);
     void receive_cbk(boost::system::error_code const &_error,
                      std::size_t _bytes);
+
+    // Length prefix of the frame that is currently written
+    uint32_t send_frame_size_;
 };
 
 } // namespace vsomeip
@@ -23,6 +23,8 @@
 
 namespace vsomeip {
 
+class local_shm_ring;
+
 #ifdef WIN32
 typedef server_endpoint_impl<boost::asio::ip::tcp,
         VSOMEIP_MAX_TCP_MESSAGE_SIZE > local_server_endpoint_base_impl;
@@ -48,6 +50,8 @@ public:
 
     bool send_to(const std::shared_ptr<endpoint_definition>,
                  const byte_t *_data, uint32_t _size, bool _flush);
+    bool send_to(const std::shared_ptr<endpoint_definition>,
+                 const message_buffer_ptr_t &_buffer, bool _flush);
     void send_queued(queue_iterator_type _queue_iterator);
 
     endpoint_type get_remote() const;
@@ -82,9 +86,15 @@ private:
         receive_buffer_t recv_buffer_;
         size_t recv_buffer_size_;
 
+        std::shared_ptr<local_shm_ring> ring_;
+
     private:
         void receive_cbk(boost::system::error_code const &_error,
                          std::size_t _bytes);
+
+        void on_message(std::shared_ptr<endpoint_host> &_host,
+                        const byte_t *_data, uint32_t _size);
+        void receive_ring(std::shared_ptr<endpoint_host> &_host);
     };
 
 #ifdef WIN32
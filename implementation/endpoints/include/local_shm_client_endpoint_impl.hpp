@@ -0,0 +1,56 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef VSOMEIP_LOCAL_SHM_CLIENT_ENDPOINT_IMPL_HPP
+#define VSOMEIP_LOCAL_SHM_CLIENT_ENDPOINT_IMPL_HPP
+
+#include <deque>
+#include <mutex>
+#include <string>
+
+#include <boost/asio/system_timer.hpp>
+
+#include "local_client_endpoint_impl.hpp"
+
+namespace vsomeip {
+
+class local_shm_ring;
+
+// Local client endpoint that transports its messages through a shared
+// memory ring. The stream socket is only used to hand over the ring and
+// to wake up the receiver if it ran out of data.
+class local_shm_client_endpoint_impl: public local_client_endpoint_impl {
+public:
+    local_shm_client_endpoint_impl(std::shared_ptr<endpoint_host> _host,
+                                   endpoint_type _remote,
+                                   boost::asio::io_service &_io,
+                                   std::uint32_t _max_message_size,
+                                   const std::string &_ring_name);
+    virtual ~local_shm_client_endpoint_impl();
+
+    bool send(const uint8_t *_data, uint32_t _size, bool _flush);
+    bool send(const message_buffer_ptr_t &_buffer, bool _flush);
+    void stop();
+
+private:
+    void connect();
+
+    void send_attach();
+    void send_notify();
+
+    void retry_cbk(boost::system::error_code const &_error);
+
+    std::string ring_name_;
+    std::uint32_t ring_size_;
+    std::shared_ptr<local_shm_ring> ring_;
+
+    std::deque<message_buffer_ptr_t> pending_;
+    boost::asio::system_timer retry_timer_;
+    std::mutex ring_mutex_;
+};
+
+} // namespace vsomeip
+
+#endif // VSOMEIP_LOCAL_SHM_CLIENT_ENDPOINT_IMPL_HPP
@@ -0,0 +1,69 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef VSOMEIP_LOCAL_SHM_RING_HPP
+#define VSOMEIP_LOCAL_SHM_RING_HPP
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include <vsomeip/primitive_types.hpp>
+
+namespace vsomeip {
+
+// Single producer / single consumer ring buffer located in a POSIX shared
+// memory segment. The producer (sender process) creates the segment, the
+// consumer (receiver process) opens it by name. Records are stored
+// contiguously (length prefixed), so the consumer can hand them to the
+// routing host without copying.
+class local_shm_ring {
+public:
+    static std::shared_ptr<local_shm_ring> create(const std::string &_name,
+            std::uint32_t _capacity);
+    static std::shared_ptr<local_shm_ring> open(const std::string &_name);
+
+    ~local_shm_ring();
+
+    const std::string & get_name() const;
+    std::uint32_t get_capacity() const;
+
+    // Producer side
+    bool push(const byte_t *_data, std::uint32_t _size);
+    bool notify();
+    void unlink();
+
+    // Consumer side
+    bool front(const byte_t *&_data, std::uint32_t &_size);
+    void pop(std::uint32_t _size);
+    bool wait();
+
+private:
+    struct header {
+        std::atomic<std::uint64_t> head_;
+        char head_padding_[64 - sizeof(std::atomic<std::uint64_t>)];
+        std::atomic<std::uint64_t> tail_;
+        char tail_padding_[64 - sizeof(std::atomic<std::uint64_t>)];
+        std::atomic<std::uint32_t> is_waiting_;
+        std::uint32_t capacity_;
+    };
+
+    local_shm_ring(const std::string &_name, void *_segment,
+            std::size_t _segment_size);
+
+    static std::uint32_t get_record_size(std::uint32_t _size);
+
+    std::string name_;
+    void *segment_;
+    std::size_t segment_size_;
+
+    header *header_;
+    byte_t *data_;
+    std::uint32_t mask_;
+};
+
+} // namespace vsomeip
+
+#endif // VSOMEIP_LOCAL_SHM_RING_HPP
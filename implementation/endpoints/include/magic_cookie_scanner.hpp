@@ -0,0 +1,112 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef VSOMEIP_MAGIC_COOKIE_SCANNER_HPP
+#define VSOMEIP_MAGIC_COOKIE_SCANNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <vsomeip/primitive_types.hpp>
+
+namespace vsomeip {
+
+// Searches stream data for magic cookies. Every cookie starts with two
+// 0xFF bytes, so the vector unit is used to find the positions of 0xFFFF
+// and only these are compared against the complete cookie. The vector
+// width is chosen at compile time (AVX2, SSE2 or bytewise).
+class magic_cookie_scanner {
+public:
+    // Returns the offset of the first cookie that starts in front of the
+    // last 16 bytes of the data or 0xFFFFFFFF if there is none.
+    static uint32_t find(const byte_t *_data, std::size_t _size,
+            byte_t _identifier, byte_t _type) {
+        const byte_t its_cookie[] = {
+            0xFF, 0xFF, _identifier, 0x00, 0x00, 0x00, 0x00, 0x08,
+            0xDE, 0xAD, 0xBE, 0xEF, 0x01, 0x01, _type, 0x00
+        };
+
+        if (_size <= sizeof(its_cookie))
+            return 0xFFFFFFFF;
+
+        const std::size_t its_end = _size - sizeof(its_cookie);
+        std::size_t its_offset = 0;
+
+#if defined(__AVX2__)
+        const __m256i its_ff = _mm256_set1_epi8(static_cast<char>(0xFF));
+        for (; its_offset + 33 <= _size && its_offset < its_end;
+                its_offset += 32) {
+            __m256i its_first = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i *>(&_data[its_offset]));
+            __m256i its_second = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i *>(&_data[its_offset + 1]));
+            uint32_t its_mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+                    _mm256_and_si256(_mm256_cmpeq_epi8(its_first, its_ff),
+                            _mm256_cmpeq_epi8(its_second, its_ff))));
+            if (check(_data, its_offset, its_mask, its_end, its_cookie))
+                return get_offset(its_offset, its_mask);
+        }
+#elif defined(__SSE2__)
+        const __m128i its_ff = _mm_set1_epi8(static_cast<char>(0xFF));
+        for (; its_offset + 17 <= _size && its_offset < its_end;
+                its_offset += 16) {
+            __m128i its_first = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(&_data[its_offset]));
+            __m128i its_second = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(&_data[its_offset + 1]));
+            uint32_t its_mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                    _mm_and_si128(_mm_cmpeq_epi8(its_first, its_ff),
+                            _mm_cmpeq_epi8(its_second, its_ff))));
+            if (check(_data, its_offset, its_mask, its_end, its_cookie))
+                return get_offset(its_offset, its_mask);
+        }
+#endif
+
+        for (; its_offset < its_end; its_offset++) {
+            if (_data[its_offset] == 0xFF && _data[its_offset + 1] == 0xFF
+                    && 0 == std::memcmp(&_data[its_offset], its_cookie,
+                            sizeof(its_cookie)))
+                return uint32_t(its_offset);
+        }
+
+        return 0xFFFFFFFF;
+    }
+
+private:
+#if defined(__AVX2__) || defined(__SSE2__)
+    // Reduces _mask to the lowest candidate that is a cookie. Returns true
+    // if one was found or if the candidates passed the end of the search.
+    static bool check(const byte_t *_data, std::size_t _offset,
+            uint32_t &_mask, std::size_t _end, const byte_t *_cookie) {
+        while (_mask) {
+            std::size_t its_candidate = _offset + std::size_t(__builtin_ctz(_mask));
+            if (its_candidate >= _end) {
+                _mask = 0;
+                return true;
+            }
+            if (0 == std::memcmp(&_data[its_candidate], _cookie, 16))
+                return true;
+            _mask &= _mask - 1;
+        }
+        return false;
+    }
+
+    static uint32_t get_offset(std::size_t _offset, uint32_t _mask) {
+        return (_mask ? uint32_t(_offset + std::size_t(__builtin_ctz(_mask)))
+                : 0xFFFFFFFF);
+    }
+#endif
+};
+
+} // namespace vsomeip
+
+#endif // VSOMEIP_MAGIC_COOKIE_SCANNER_HPP
@@ -6,6 +6,7 @@
 #ifndef VSOMEIP_SERVER_IMPL_HPP
 #define VSOMEIP_SERVER_IMPL_HPP
 
+#include <chrono>
 #include <deque>
 #include <map>
 #include <memory>
@@ -18,6 +19,7 @@
 
 #include "buffer.hpp"
 #include "endpoint_impl.hpp"
+#include "../../utility/include/timer_wheel.hpp"
 
 namespace vsomeip {
 
@@ -40,31 +42,50 @@ public:
     bool is_connected() const;
 
     bool send(const uint8_t *_data, uint32_t _size, bool _flush);
+    bool send(const message_buffer_ptr_t &_buffer, bool _flush);
     bool flush(endpoint_type _target);
 
+    void set_flush_policy(service_t _service, std::uint32_t _max_delay,
+                          std::uint32_t _max_bytes);
+
 public:
     void connect_cbk(boost::system::error_code const &_error);
     void send_cbk(queue_iterator_type _queue_iterator,
                   boost::system::error_code const &_error, std::size_t _bytes);
-    void flush_cbk(endpoint_type _target,
-                   const boost::system::error_code &_error);
+    void flush_cbk(const boost::system::error_code &_error);
 
 public:
     virtual bool send_intern(endpoint_type _target, const byte_t *_data,
                              uint32_t _port, bool _flush);
+    virtual bool send_intern(endpoint_type _target,
+                             const message_buffer_ptr_t &_buffer, bool _flush);
     virtual void send_queued(queue_iterator_type _queue_iterator) = 0;
 
     virtual endpoint_type get_remote() const = 0;
     virtual bool get_multicast(service_t _service, event_t _event,
                                endpoint_type &_target) const = 0;
 
+private:
+    struct flush_policy {
+        std::chrono::milliseconds max_delay_;
+        std::uint32_t max_bytes_;
+    };
+
+    void start_flush_timer();
+    void flush_packetizer(endpoint_type _target);
+
 protected:
     std::map<endpoint_type, message_buffer_ptr_t> packetizer_;
     queue_type queues_;
 
     std::map<client_t, std::map<session_t, endpoint_type> > clients_;
 
+    // Packetizers waiting to be flushed, a single timer drives the wheel
+    // as long as it is not empty.
+    std::map<service_t, flush_policy> flush_policies_;
+    timer_wheel<endpoint_type> flush_wheel_;
     boost::asio::system_timer flush_timer_;
+    bool is_flush_timer_running_;
 
     endpoint_type local_;
 
@@ -35,13 +35,15 @@ public:
 private:
     void send_queued();
     bool is_magic_cookie(size_t _offset) const;
-    void send_magic_cookie(message_buffer_ptr_t &_buffer);
+    boost::asio::const_buffer get_magic_cookie(
+            const message_buffer_ptr_t &_buffer) const;
 
     void receive_cbk(boost::system::error_code const &_error,
                      std::size_t _bytes);
 
     void connect();
     void receive();
+    void adjust_receive_buffer();
 
     receive_buffer_t recv_buffer_;
     size_t recv_buffer_size_;
@@ -33,6 +33,8 @@ public:
 
     bool send_to(const std::shared_ptr<endpoint_definition> _target,
                  const byte_t *_data, uint32_t _size, bool _flush);
+    bool send_to(const std::shared_ptr<endpoint_definition> _target,
+                 const message_buffer_ptr_t &_buffer, bool _flush);
     void send_queued(queue_iterator_type _queue_iterator);
 
     endpoint_type get_remote() const;
@@ -40,6 +42,7 @@ public:
     bool get_multicast(service_t, event_t, endpoint_type &) const;
 
     unsigned short get_local_port() const;
+    unsigned short get_remote_port() const;
     bool is_reliable() const;
     bool is_local() const;
 
@@ -70,7 +73,8 @@ private:
 
     private:
         connection(tcp_server_endpoint_impl *_owner, std::uint32_t _max_message_size);
-        void send_magic_cookie(message_buffer_ptr_t &_buffer);
+        boost::asio::const_buffer get_magic_cookie(
+                const message_buffer_ptr_t &_buffer) const;
 
         tcp_server_endpoint_impl::socket_type socket_;
         tcp_server_endpoint_impl *server_;
@@ -82,6 +86,7 @@ private:
 
     private:
         bool is_magic_cookie(size_t _offset) const;
+        void adjust_receive_buffer();
         void receive_cbk(boost::system::error_code const &_error,
                          std::size_t _bytes);
         std::mutex stop_mutex_;
@@ -0,0 +1,81 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef VSOMEIP_TP_HPP
+#define VSOMEIP_TP_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/ip/udp.hpp>
+
+#include <vsomeip/primitive_types.hpp>
+
+#include "buffer.hpp"
+
+namespace vsomeip {
+
+// SOME/IP transport protocol. Messages that do not fit into a datagram are
+// sent as a sequence of segments. Each segment carries a copy of the
+// SOME/IP header with the TP flag set in the message type, followed by the
+// offset of its payload within the message and a "more segments" flag.
+// Segments may arrive in any order, they are collected per sender and
+// message until the message is complete or its reassembly timed out.
+class tp {
+public:
+    typedef boost::asio::ip::udp::endpoint endpoint_type;
+
+    tp();
+
+    void set_policy(service_t _service, std::uint32_t _max_segment_length,
+            std::uint32_t _max_message_size, std::uint32_t _timeout);
+
+    // Splits the message into segments that do not exceed _max_size.
+    // Returns false if the service of the message does not use SOME/IP-TP.
+    bool segment(const byte_t *_data, std::uint32_t _size,
+            std::uint32_t _max_size,
+            std::vector<message_buffer_ptr_t> &_segments) const;
+
+    // Adds a segment. Returns the reassembled message once the last
+    // missing segment arrived, an empty pointer otherwise.
+    message_buffer_ptr_t reassemble(const endpoint_type &_sender,
+            const byte_t *_data, std::uint32_t _size);
+
+    static bool is_segment(const byte_t *_data, std::uint32_t _size);
+
+private:
+    struct policy {
+        std::uint32_t max_segment_length_;
+        std::uint32_t max_message_size_;
+        std::chrono::milliseconds timeout_;
+    };
+
+    struct message {
+        message_buffer_ptr_t buffer_;
+        // Offset -> length of the received segments
+        std::map<std::uint32_t, std::uint32_t> segments_;
+        std::uint32_t received_;
+        bool has_last_;
+        std::chrono::steady_clock::time_point expiration_;
+    };
+
+    // Sender and message/request id of the segmented message
+    typedef std::pair<endpoint_type, std::uint64_t> message_key_t;
+
+    void expire(std::chrono::steady_clock::time_point _now);
+    void limit(const endpoint_type &_sender);
+
+    mutable std::mutex mutex_;
+    std::map<service_t, policy> policies_;
+    std::map<message_key_t, message> messages_;
+};
+
+} // namespace vsomeip
+
+#endif // VSOMEIP_TP_HPP
@@ -14,6 +14,7 @@
 #include <vsomeip/defines.hpp>
 
 #include "client_endpoint_impl.hpp"
+#include "tp.hpp"
 
 namespace vsomeip {
 
@@ -32,6 +33,12 @@ public:
 
     void start();
 
+    bool send(const uint8_t *_data, uint32_t _size, bool _flush);
+    bool send(const message_buffer_ptr_t &_buffer, bool _flush);
+
+    void set_tp_policy(service_t _service, std::uint32_t _max_segment_length,
+            std::uint32_t _max_message_size, std::uint32_t _timeout);
+
     void receive_cbk(boost::system::error_code const &_error,
                      std::size_t _bytes);
                      
@@ -47,6 +54,8 @@ private:
 
     receive_buffer_t recv_buffer_;
     size_t recv_buffer_size_;
+
+    tp tp_;
 };
 
 } // namespace vsomeip
@@ -6,11 +6,17 @@
 #ifndef VSOMEIP_INTERNAL_UDP_SERVICE_IMPL_HPP
 #define VSOMEIP_INTERNAL_UDP_SERVICE_IMPL_HPP
 
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/ip/udp.hpp>
 
 #include <vsomeip/defines.hpp>
 #include "server_endpoint_impl.hpp"
+#include "tp.hpp"
+#include "uring_receiver.hpp"
 
 namespace vsomeip {
 
@@ -33,8 +39,20 @@ public:
 
     bool send_to(const std::shared_ptr<endpoint_definition> _target,
             const byte_t *_data, uint32_t _size, bool _flush);
+    bool send_to(const std::shared_ptr<endpoint_definition> _target,
+            const message_buffer_ptr_t &_buffer, bool _flush);
+    bool send_to(
+            const std::vector<std::shared_ptr<endpoint_definition> > &_targets,
+            const message_buffer_ptr_t &_buffer);
+    bool send_intern(endpoint_type _target, const byte_t *_data,
+            uint32_t _size, bool _flush);
+    bool send_intern(endpoint_type _target,
+            const message_buffer_ptr_t &_buffer, bool _flush);
     void send_queued(queue_iterator_type _queue_iterator);
 
+    void set_tp_policy(service_t _service, std::uint32_t _max_segment_length,
+            std::uint32_t _max_message_size, std::uint32_t _timeout);
+
     endpoint_type get_remote() const;
     bool get_remote_address(boost::asio::ip::address &_address) const;
     bool get_multicast(service_t _service, event_t _event,
@@ -47,16 +65,27 @@ public:
     void remove_multicast(service_t _service, instance_t _instance);
 
     unsigned short get_local_port() const;
+    unsigned short get_remote_port() const;
     bool is_local() const;
 
     client_t get_client(std::shared_ptr<endpoint_definition> _endpoint);
 
+    void enable_io_uring(std::uint32_t _buffers);
+
 public:
     void receive_cbk(boost::system::error_code const &_error,
                      std::size_t _size);
+#ifdef __linux__
+    void receive_batch_cbk(boost::system::error_code const &_error);
+#endif
+#ifdef USE_IO_URING
+    void receive_uring_cbk(boost::system::error_code const &_error);
+#endif
 
 private:
     void set_broadcast();
+    void deliver(const std::shared_ptr<endpoint_host> &_host,
+                 const byte_t *_data, std::size_t _size);
 
 private:
     socket_type socket_;
@@ -65,7 +94,20 @@ private:
 
     receive_buffer_t recv_buffer_;
     size_t recv_buffer_size_;
+#ifdef __linux__
+    // Datagrams that are fetched by a single recvmmsg call
+    std::vector<receive_buffer_t> batch_buffers_;
+    std::vector<endpoint_type> batch_remotes_;
+    std::vector<struct iovec> batch_vectors_;
+    std::vector<struct mmsghdr> batch_headers_;
+#endif
+#ifdef USE_IO_URING
+    std::shared_ptr<uring_receiver> uring_;
+    std::vector<uring_receiver::datagram> uring_datagrams_;
+#endif
     std::mutex stop_mutex_;
+
+    tp tp_;
 };
 
 } // namespace vsomeip
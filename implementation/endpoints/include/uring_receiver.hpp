@@ -0,0 +1,103 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef VSOMEIP_URING_RECEIVER_HPP
+#define VSOMEIP_URING_RECEIVER_HPP
+
+#ifdef USE_IO_URING
+
+#include <cstdint>
+#include <vector>
+
+#include <sys/socket.h>
+#include <linux/io_uring.h>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+
+#include <vsomeip/primitive_types.hpp>
+
+namespace vsomeip {
+
+// Receives datagrams from a socket by a single multishot receive on an
+// io_uring. The kernel picks the receive buffers from a registered buffer
+// ring and posts a completion per datagram, so no system call is needed
+// for a single datagram. The ring descriptor is waited for by the
+// io_service like any other socket.
+class uring_receiver {
+public:
+    struct datagram {
+        const byte_t *data_;
+        std::size_t size_;
+        const struct sockaddr *name_;
+        socklen_t namelen_;
+        std::uint16_t buffer_;
+    };
+
+    uring_receiver(boost::asio::io_service &_io);
+    ~uring_receiver();
+
+    // Sets up the ring and arms the receive. Returns false if the kernel
+    // does not support receives on io_uring or buffer rings. Whether the
+    // multishot receive is supported shows only by its first completion.
+    bool start(int _socket, std::uint32_t _buffers, std::size_t _max_size);
+    void stop();
+
+    template<typename Handler>
+    void async_wait(Handler _handler) {
+        descriptor_.async_read_some(boost::asio::null_buffers(), _handler);
+    }
+
+    // Appends the datagrams that were received since the last call. Their
+    // data stays valid until it is passed to release.
+    void fetch(std::vector<datagram> &_datagrams);
+    void release(const std::vector<datagram> &_datagrams);
+
+    // True once the kernel rejected the multishot receive. The receiver
+    // must then be stopped and the socket read otherwise.
+    bool is_unsupported() const { return is_unsupported_; }
+
+private:
+    bool setup(std::uint32_t _buffers);
+    bool arm();
+    void provide(std::uint16_t _buffer);
+    void cleanup();
+
+    boost::asio::posix::stream_descriptor descriptor_;
+    int fd_;
+    int socket_;
+    bool is_armed_;
+    bool is_unsupported_;
+
+    void *sq_ring_;
+    std::size_t sq_ring_size_;
+    void *cq_ring_;
+    std::size_t cq_ring_size_;
+    struct io_uring_sqe *sqes_;
+    std::size_t sqes_size_;
+
+    unsigned *sq_tail_;
+    unsigned *sq_mask_;
+    unsigned *sq_array_;
+    unsigned *cq_head_;
+    unsigned *cq_tail_;
+    unsigned *cq_mask_;
+    struct io_uring_cqe *cqes_;
+
+    struct io_uring_buf_ring *buf_ring_;
+    std::size_t buf_ring_size_;
+    std::uint32_t buf_entries_;
+    std::uint16_t buf_tail_;
+    std::size_t buffer_size_;
+    std::vector<byte_t> buffers_;
+
+    struct msghdr header_;
+};
+
+} // namespace vsomeip
+
+#endif // USE_IO_URING
+
+#endif // VSOMEIP_URING_RECEIVER_HPP
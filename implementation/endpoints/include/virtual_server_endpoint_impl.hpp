@@ -27,8 +27,14 @@ public:
     bool is_connected() const;
 
     bool send(const byte_t *_data, uint32_t _size, bool _flush);
+    bool send(const message_buffer_ptr_t &_buffer, bool _flush);
     bool send_to(const std::shared_ptr<endpoint_definition> _target,
             const byte_t *_data, uint32_t _size, bool _flush);
+    bool send_to(const std::shared_ptr<endpoint_definition> _target,
+            const message_buffer_ptr_t &_buffer, bool _flush);
+    bool send_to(
+            const std::vector<std::shared_ptr<endpoint_definition> > &_targets,
+            const message_buffer_ptr_t &_buffer);
     void enable_magic_cookies();
     void receive();
 
@@ -39,6 +45,11 @@ public:
             const std::string &_address, uint16_t _port);
     void remove_multicast(service_t _service, event_t _event);
 
+    void set_flush_policy(service_t _service, std::uint32_t _max_delay,
+            std::uint32_t _max_bytes);
+    void set_tp_policy(service_t _service, std::uint32_t _max_segment_length,
+            std::uint32_t _max_message_size, std::uint32_t _timeout);
+
     bool get_remote_address(boost::asio::ip::address &_address) const;
     unsigned short get_local_port() const;
     unsigned short get_remote_port() const;
@@ -31,8 +31,8 @@ client_endpoint_impl<Protocol, MaxBufferSize>::client_endpoint_impl(
           socket_(_io), remote_(_remote),
           flush_timer_(_io), connect_timer_(_io),
           connect_timeout_(VSOMEIP_DEFAULT_CONNECT_TIMEOUT), // TODO: use config variable
-          is_connected_(false),
-          packetizer_(std::make_shared<message_buffer_t>()) {
+          is_connected_(false) {
+    packetizer_ = this->create_packetizer();
 }
 
 template<typename Protocol, int MaxBufferSize>
@@ -75,6 +75,36 @@ bool client_endpoint_impl<Protocol, MaxBufferSize>::send_to(
     return false;
 }
 
+template<typename Protocol, int MaxBufferSize>
+bool client_endpoint_impl<Protocol, MaxBufferSize>::send_to(
+        const std::shared_ptr<endpoint_definition> _target,
+        const message_buffer_ptr_t &_buffer, bool _flush) {
+    (void)_target;
+    (void)_buffer;
+    (void)_flush;
+
+    VSOMEIP_ERROR<< "Clients endpoints must not be used to "
+    << "send to explicitely specified targets";
+    return false;
+}
+
+template<typename Protocol, int MaxBufferSize>
+bool client_endpoint_impl<Protocol, MaxBufferSize>::send(
+        const message_buffer_ptr_t &_buffer, bool _flush) {
+    {
+        std::lock_guard<std::mutex> its_lock(mutex_);
+        // Nothing to pack the buffer with --> queue it without copying
+        if (_flush && packetizer_->empty()) {
+            queue_.push_back(_buffer);
+            if (queue_.size() == 1) { // no writing in progress
+                send_queued();
+            }
+            return true;
+        }
+    }
+    return send(&(*_buffer)[0], uint32_t(_buffer->size()), _flush);
+}
+
 template<typename Protocol, int MaxBufferSize>
 bool client_endpoint_impl<Protocol, MaxBufferSize>::send(const uint8_t *_data,
         uint32_t _size, bool _flush) {
@@ -92,7 +122,7 @@ bool client_endpoint_impl<Protocol, MaxBufferSize>::send(const uint8_t *_data,
     if (packetizer_->size() + _size > endpoint_impl<MaxBufferSize>::max_message_size_) {
         queue_.push_back(packetizer_);
         is_flushing = true;
-        packetizer_ = std::make_shared<message_buffer_t>();
+        packetizer_ = this->create_packetizer();
     }
 
     packetizer_->insert(packetizer_->end(), _data, _data + _size);
@@ -101,7 +131,7 @@ bool client_endpoint_impl<Protocol, MaxBufferSize>::send(const uint8_t *_data,
         flush_timer_.cancel();
         queue_.push_back(packetizer_);
         is_flushing = true;
-        packetizer_ = std::make_shared<message_buffer_t>();
+        packetizer_ = this->create_packetizer();
     } else {
         flush_timer_.expires_from_now(
                 std::chrono::milliseconds(VSOMEIP_DEFAULT_FLUSH_TIMEOUT)); // TODO: use config variable
@@ -124,10 +154,10 @@ template<typename Protocol, int MaxBufferSize>
 bool client_endpoint_impl<Protocol, MaxBufferSize>::flush() {
     bool is_successful(true);
 
+    std::lock_guard<std::mutex> its_lock(mutex_);
     if (!packetizer_->empty()) {
-        std::lock_guard<std::mutex> its_lock(mutex_);
         queue_.push_back(packetizer_);
-        packetizer_ = std::make_shared<message_buffer_t>();
+        packetizer_ = this->create_packetizer();
         if (queue_.size() == 1) { // no writing in progress
             send_queued();
         }
@@ -188,7 +218,9 @@ void client_endpoint_impl<Protocol, MaxBufferSize>::send_cbk(
     (void)_bytes;
     if (!_error) {
         std::lock_guard<std::mutex> its_lock(mutex_);
+        message_buffer_ptr_t its_buffer = queue_.front();
         queue_.pop_front();
+        this->recycle_packetizer(its_buffer);
         if (queue_.size() > 0) {
             send_queued();
         }
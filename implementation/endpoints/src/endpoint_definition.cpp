@@ -3,39 +3,93 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
+
 #include <vsomeip/constants.hpp>
 
 #include "../include/endpoint_definition.hpp"
+#include "../../configuration/include/internal.hpp"
 
 namespace vsomeip {
 
-std::map<boost::asio::ip::address,
-    std::map<uint16_t,
-        std::map<bool, std::shared_ptr<endpoint_definition> > > >
-endpoint_definition::definitions_;
+std::shared_ptr<const endpoint_definition::definitions_t>
+endpoint_definition::definitions_
+    = std::make_shared<endpoint_definition::definitions_t>();
+std::mutex endpoint_definition::definitions_mutex_;
+endpoint_definition::definitions_t endpoint_definition::added_;
+std::vector<std::shared_ptr<endpoint_definition> >
+endpoint_definition::recent_(VSOMEIP_RECENT_ENDPOINT_DEFINITIONS);
+std::size_t endpoint_definition::recent_position_(0);
+
+std::size_t endpoint_definition::key_hash::operator()(const key &_key) const {
+    std::size_t its_hash(_key.port_);
+    its_hash = (its_hash << 1) | (_key.is_reliable_ ? 1 : 0);
+    if (_key.address_.is_v4()) {
+        its_hash ^= std::size_t(_key.address_.to_v4().to_ulong()) << 17;
+    } else {
+        for (auto its_byte : _key.address_.to_v6().to_bytes())
+            its_hash = its_hash * 31 + its_byte;
+    }
+    return its_hash;
+}
+
+std::shared_ptr<endpoint_definition>
+endpoint_definition::find(const definitions_t &_definitions, const key &_key) {
+    auto found_definition = _definitions.find(_key);
+    if (found_definition != _definitions.end())
+        return found_definition->second.lock();
+    return nullptr;
+}
+
+// Must be called with definitions_mutex_ being locked.
+void endpoint_definition::publish() {
+    std::shared_ptr<const definitions_t> its_definitions
+        = std::atomic_load(&definitions_);
+    std::shared_ptr<definitions_t> its_copy
+        = std::make_shared<definitions_t>();
+    its_copy->reserve(its_definitions->size() + added_.size());
+    for (auto &its_definition : *its_definitions) {
+        if (!its_definition.second.expired())
+            its_copy->insert(its_definition);
+    }
+    for (auto &its_definition : added_) {
+        if (!its_definition.second.expired())
+            (*its_copy)[its_definition.first] = its_definition.second;
+    }
+    added_.clear();
+    std::atomic_store(&definitions_,
+            std::shared_ptr<const definitions_t>(its_copy));
+}
 
 std::shared_ptr<endpoint_definition>
 endpoint_definition::get(const boost::asio::ip::address &_address,
                          uint16_t _port, bool _is_reliable) {
 
-    std::shared_ptr<endpoint_definition> its_result;
+    const key its_key = { _address, _port, _is_reliable };
+    std::shared_ptr<endpoint_definition> its_result
+        = find(*std::atomic_load(&definitions_), its_key);
 
-    auto find_address = definitions_.find(_address);
-    if (find_address != definitions_.end()) {
-        auto find_port = find_address->second.find(_port);
-        if (find_port != find_address->second.end()) {
-            auto found_reliable = find_port->second.find(_is_reliable);
-            if (found_reliable != find_port->second.end()) {
-                its_result = found_reliable->second;
+    if (!its_result) {
+        std::lock_guard<std::mutex> its_lock(definitions_mutex_);
+        its_result = find(added_, its_key);
+        if (!its_result)
+            its_result = find(*std::atomic_load(&definitions_), its_key);
+
+        if (!its_result) {
+            its_result = std::make_shared<endpoint_definition>(
+                             _address, _port, _is_reliable);
+            added_[its_key] = its_result;
+            recent_[recent_position_] = its_result;
+            recent_position_ = (recent_position_ + 1) % recent_.size();
+
+            std::size_t its_published
+                = std::atomic_load(&definitions_)->size();
+            if (added_.size() >= std::max(its_published,
+                    std::size_t(VSOMEIP_MIN_ENDPOINT_DEFINITIONS_MERGE))) {
+                publish();
             }
         }
     }
-
-    if (!its_result) {
-        its_result = std::make_shared<endpoint_definition>(
-                         _address, _port, _is_reliable);
-        definitions_[_address][_port][_is_reliable] = its_result;
-    }
     return its_result;
 }
 
@@ -8,6 +8,8 @@
 
 #include "../include/endpoint_host.hpp"
 #include "../include/endpoint_impl.hpp"
+#include "../include/magic_cookie_scanner.hpp"
+#include "../../configuration/include/internal.hpp"
 #include "../../logging/include/logger.hpp"
 
 namespace vsomeip {
@@ -40,50 +42,57 @@ bool endpoint_impl<MaxBufferSize>::is_magic_cookie() const {
 template<int MaxBufferSize>
 uint32_t endpoint_impl<MaxBufferSize>::find_magic_cookie(
         byte_t *_buffer, size_t _size) {
-    bool is_found(false);
     uint32_t its_offset = 0xFFFFFFFF;
     if (has_enabled_magic_cookies_) {
-        uint8_t its_cookie_identifier, its_cookie_type;
-
         if (is_client()) {
-            its_cookie_identifier =
-                    static_cast<uint8_t>(MAGIC_COOKIE_SERVICE_MESSAGE);
-            its_cookie_type =
-                    static_cast<uint8_t>(MAGIC_COOKIE_SERVICE_MESSAGE_TYPE);
+            its_offset = magic_cookie_scanner::find(_buffer, _size,
+                    static_cast<byte_t>(MAGIC_COOKIE_SERVICE_MESSAGE),
+                    static_cast<byte_t>(MAGIC_COOKIE_SERVICE_MESSAGE_TYPE));
         } else {
-            its_cookie_identifier =
-                    static_cast<uint8_t>(MAGIC_COOKIE_CLIENT_MESSAGE);
-            its_cookie_type =
-                    static_cast<uint8_t>(MAGIC_COOKIE_CLIENT_MESSAGE_TYPE);
+            its_offset = magic_cookie_scanner::find(_buffer, _size,
+                    static_cast<byte_t>(MAGIC_COOKIE_CLIENT_MESSAGE),
+                    static_cast<byte_t>(MAGIC_COOKIE_CLIENT_MESSAGE_TYPE));
         }
+    }
+    return its_offset;
+}
 
-        do {
-            its_offset++; // --> first loop has "its_offset = 0"
-            if (_size > its_offset + 16) {
-                is_found = (_buffer[its_offset] == 0xFF
-                         && _buffer[its_offset + 1] == 0xFF
-                         && _buffer[its_offset + 2] == its_cookie_identifier
-                         && _buffer[its_offset + 3] == 0x00
-                         && _buffer[its_offset + 4] == 0x00
-                         && _buffer[its_offset + 5] == 0x00
-                         && _buffer[its_offset + 6] == 0x00
-                         && _buffer[its_offset + 7] == 0x08
-                         && _buffer[its_offset + 8] == 0xDE
-                         && _buffer[its_offset + 9] == 0xAD
-                         && _buffer[its_offset + 10] == 0xBE
-                         && _buffer[its_offset + 11] == 0xEF
-                         && _buffer[its_offset + 12] == 0x01
-                         && _buffer[its_offset + 13] == 0x01
-                         && _buffer[its_offset + 14] == its_cookie_type
-                         && _buffer[its_offset + 15] == 0x00);
-            } else {
-                break;
-            }
-
-        } while (!is_found);
+template<int MaxBufferSize>
+bool endpoint_impl<MaxBufferSize>::send_to(
+        const std::vector<std::shared_ptr<endpoint_definition> > &_targets,
+        const message_buffer_ptr_t &_buffer) {
+    bool is_sent(true);
+    for (auto its_target : _targets) {
+        if (!send_to(its_target, _buffer, true))
+            is_sent = false;
     }
+    return is_sent;
+}
 
-    return (is_found ? its_offset : 0xFFFFFFFF);
+template<int MaxBufferSize>
+message_buffer_ptr_t endpoint_impl<MaxBufferSize>::create_packetizer() {
+    message_buffer_ptr_t its_packetizer;
+    if (!spare_packetizers_.empty()) {
+        its_packetizer = spare_packetizers_.back();
+        spare_packetizers_.pop_back();
+    } else {
+        its_packetizer = std::make_shared<message_buffer_t>();
+        its_packetizer->reserve(max_message_size_ < VSOMEIP_PACKETIZER_RESERVE ?
+                max_message_size_ : VSOMEIP_PACKETIZER_RESERVE);
+    }
+    return its_packetizer;
+}
+
+template<int MaxBufferSize>
+void endpoint_impl<MaxBufferSize>::recycle_packetizer(
+        const message_buffer_ptr_t &_buffer) {
+    // Shared buffers may still be sent by other endpoints
+    if (_buffer.unique()
+            && _buffer->capacity() <= max_message_size_
+            && spare_packetizers_.size() < VSOMEIP_MAX_SPARE_PACKETIZERS) {
+        _buffer->clear();
+        spare_packetizers_.push_back(_buffer);
+    }
 }
 
 template<int MaxBufferSize>
@@ -103,6 +112,16 @@ template<int MaxBufferSize>
 void endpoint_impl<MaxBufferSize>::remove_multicast(service_t, event_t) {
 }
 
+template<int MaxBufferSize>
+void endpoint_impl<MaxBufferSize>::set_flush_policy(
+        service_t, std::uint32_t, std::uint32_t) {
+}
+
+template<int MaxBufferSize>
+void endpoint_impl<MaxBufferSize>::set_tp_policy(
+        service_t, std::uint32_t, std::uint32_t, std::uint32_t) {
+}
+
 template<int MaxBufferSize>
 bool endpoint_impl<MaxBufferSize>::get_remote_address(
         boost::asio::ip::address &_address) const {
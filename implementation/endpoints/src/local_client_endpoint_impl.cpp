@@ -3,6 +3,7 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <array>
 #include <iomanip>
 #include <sstream>
 
@@ -19,7 +20,8 @@ namespace vsomeip {
 local_client_endpoint_impl::local_client_endpoint_impl(
         std::shared_ptr< endpoint_host > _host, endpoint_type _remote,
         boost::asio::io_service &_io, std::uint32_t _max_message_size)
-    : local_client_endpoint_base_impl(_host, _remote, _io, _max_message_size) {
+    : local_client_endpoint_base_impl(_host, _remote, _io, _max_message_size),
+      send_frame_size_(0) {
     is_supporting_magic_cookies_ = false;
 }
 
@@ -59,27 +61,6 @@ void local_client_endpoint_impl::receive() {
 }
 
 void local_client_endpoint_impl::send_queued() {
-    static byte_t its_start_tag[] = { 0x67, 0x37, 0x6D, 0x07 };
-
-    boost::asio::async_write(
-        socket_,
-        boost::asio::buffer(
-            its_start_tag,
-            sizeof(its_start_tag)
-        ),
-        std::bind(
-            &local_client_endpoint_impl::send_start_tag_cbk,
-            std::dynamic_pointer_cast<
-                local_client_endpoint_impl
-            >(shared_from_this()),
-            std::placeholders::_1,
-            std::placeholders::_2
-        )
-    );
-}
-
-void local_client_endpoint_impl::send_queued_data() {
-    std::lock_guard<std::mutex> its_lock(mutex_);
     message_buffer_ptr_t its_buffer = queue_.front();
     #if 0
     std::stringstream msg;
@@ -90,29 +71,16 @@ void local_client_endpoint_impl::send_queued_data() {
     VSOMEIP_DEBUG << msg.str();
     #endif
 
-    boost::asio::async_write(
-        socket_,
-        boost::asio::buffer(*its_buffer),
-        std::bind(
-            &local_client_endpoint_impl::send_queued_data_cbk,
-            std::dynamic_pointer_cast<
-                local_client_endpoint_impl
-            >(shared_from_this()),
-            std::placeholders::_1,
-            std::placeholders::_2
-        )
-    );
-}
-
-void local_client_endpoint_impl::send_end_tag() {
-    static byte_t its_end_tag[] = { 0x07, 0x6D, 0x37, 0x67 };
+    // Frame: 4 byte length prefix followed by the (packetized) commands
+    send_frame_size_ = uint32_t(its_buffer->size());
+    std::array<boost::asio::const_buffer, 2> its_frame = {{
+        boost::asio::buffer(&send_frame_size_, sizeof(send_frame_size_)),
+        boost::asio::buffer(*its_buffer)
+    }};
 
     boost::asio::async_write(
         socket_,
-        boost::asio::buffer(
-            its_end_tag,
-            sizeof(its_end_tag)
-        ),
+        its_frame,
         std::bind(
             &client_endpoint_impl::send_cbk,
             shared_from_this(),
@@ -125,24 +93,6 @@ void local_client_endpoint_impl::send_end_tag() {
 void local_client_endpoint_impl::send_magic_cookie() {
 }
 
-void local_client_endpoint_impl::send_start_tag_cbk(
-        boost::system::error_code const &_error, std::size_t _bytes) {
-    (void)_bytes;
-    if (_error)
-        send_cbk(_error, 0);
-
-    send_queued_data();
-}
-
-void local_client_endpoint_impl::send_queued_data_cbk(
-        boost::system::error_code const &_error, std::size_t _bytes) {
-    (void)_bytes;
-    if (_error)
-        send_cbk(_error, 0);
-
-    send_end_tag();
-}
-
 void local_client_endpoint_impl::receive_cbk(
         boost::system::error_code const &_error, std::size_t _bytes) {
     (void)_error;
@@ -3,6 +3,7 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <cstring>
 #include <deque>
 #include <iomanip>
 #include <iostream>
@@ -12,7 +13,9 @@
 
 #include "../include/endpoint_host.hpp"
 #include "../include/local_server_endpoint_impl.hpp"
+#include "../include/local_shm_ring.hpp"
 
+#include "../../configuration/include/internal.hpp"
 #include "../../logging/include/logger.hpp"
 
 namespace vsomeip {
@@ -62,6 +65,15 @@ bool local_server_endpoint_impl::send_to(
     return false;
 }
 
+bool local_server_endpoint_impl::send_to(
+        const std::shared_ptr<endpoint_definition> _target,
+        const message_buffer_ptr_t &_buffer, bool _flush) {
+    (void)_target;
+    (void)_buffer;
+    (void)_flush;
+    return false;
+}
+
 void local_server_endpoint_impl::send_queued(
         queue_iterator_type _queue_iterator) {
     auto connection_iterator = connections_.find(_queue_iterator->first);
@@ -123,7 +135,7 @@ void local_server_endpoint_impl::accept_cbk(
 local_server_endpoint_impl::connection::connection(
         local_server_endpoint_impl *_server, std::uint32_t _max_message_size)
     : socket_(_server->service_), server_(_server),
-      max_message_size_(_max_message_size + 8),
+      max_message_size_(_max_message_size + sizeof(uint32_t)),
       recv_buffer_(max_message_size_, 0),
       recv_buffer_size_(0) {
 }
@@ -160,8 +172,8 @@ void local_server_endpoint_impl::connection::send_queued(
         queue_iterator_type _queue_iterator) {
 
     // TODO: We currently do _not_ use the send method of the local server
-    // endpoints. If we ever need it, we need to add the "start tag", "data",
-    // "end tag" sequence here.
+    // endpoints. If we ever need it, we need to add the length prefix
+    // of the frame here.
 
     message_buffer_ptr_t its_buffer = _queue_iterator->second.front();
 #if 0
@@ -193,10 +205,6 @@ void local_server_endpoint_impl::connection::receive_cbk(
 
     std::shared_ptr<endpoint_host> its_host = server_->host_.lock();
     if (its_host) {
-        std::size_t its_start;
-        std::size_t its_end;
-        std::size_t its_iteration_gap = 0;
-
         if (!_error && 0 < _bytes) {
     #if 0
             std::stringstream msg;
@@ -209,60 +217,45 @@ void local_server_endpoint_impl::connection::receive_cbk(
 
             recv_buffer_size_ += _bytes;
 
-    #define MESSAGE_IS_EMPTY     std::size_t(-1)
-    #define FOUND_MESSAGE        std::size_t(-2)
-
-            do {
-                its_start = 0 + its_iteration_gap;
-                while (its_start + 3 < recv_buffer_size_ + its_iteration_gap &&
-                    (recv_buffer_[its_start] != 0x67 ||
-                    recv_buffer_[its_start+1] != 0x37 ||
-                    recv_buffer_[its_start+2] != 0x6d ||
-                    recv_buffer_[its_start+3] != 0x07)) {
-                    its_start ++;
+            // Each frame is prefixed by its length, so we can jump from
+            // frame to frame and only need to wait for incomplete ones.
+            std::size_t its_offset(0);
+            while (recv_buffer_size_ - its_offset >= sizeof(uint32_t)) {
+                uint32_t its_frame_size;
+                std::memcpy(&its_frame_size, &recv_buffer_[its_offset],
+                        sizeof(its_frame_size));
+
+                if (its_frame_size > max_message_size_ - sizeof(uint32_t)) {
+                    // The rest of the frame is still to be received, so
+                    // the stream cannot be resynchronized
+                    VSOMEIP_ERROR << "Local endpoint received frame of size "
+                            << its_frame_size << " (maximum is "
+                            << max_message_size_ - sizeof(uint32_t)
+                            << "). Closing connection.";
+                    recv_buffer_size_ = 0;
+                    boost::system::error_code its_error;
+                    socket_.shutdown(socket_type::shutdown_both, its_error);
+                    socket_.close(its_error);
+                    server_->remove_connection(this);
+                    return;
                 }
 
-                its_start = (its_start + 3 == recv_buffer_size_ + its_iteration_gap ?
-                                 MESSAGE_IS_EMPTY : its_start+4);
-
-                if (its_start != MESSAGE_IS_EMPTY) {
-                    its_end = its_start;
-                    while (its_end + 3 < recv_buffer_size_ + its_iteration_gap &&
-                        (recv_buffer_[its_end] != 0x07 ||
-                        recv_buffer_[its_end+1] != 0x6d ||
-                        recv_buffer_[its_end+2] != 0x37 ||
-                        recv_buffer_[its_end+3] != 0x67)) {
-                        its_end ++;
-                    }
+                if (recv_buffer_size_ - its_offset - sizeof(uint32_t)
+                        < its_frame_size) {
+                    break;
                 }
 
-                if (its_start != MESSAGE_IS_EMPTY &&
-                    its_end + 3 < recv_buffer_size_ + its_iteration_gap) {
-                    its_host->on_message(&recv_buffer_[its_start],
-                                         uint32_t(its_end - its_start), server_);
-
-                    #if 0
-                            std::stringstream local_msg;
-                            local_msg << "lse::c<" << this << ">rcb::thunk: ";
-                            for (std::size_t i = its_start; i < its_end; i++)
-                                local_msg << std::setw(2) << std::setfill('0') << std::hex
-                                    << (int) recv_buffer_[i] << " ";
-                            VSOMEIP_DEBUG << local_msg.str();
-                    #endif
-
-                    recv_buffer_size_ -= (its_end + 4 - its_iteration_gap);
-                    its_start = FOUND_MESSAGE;
-                    its_iteration_gap = its_end + 4;
-                } else {
-                    if (its_start != MESSAGE_IS_EMPTY && its_iteration_gap) {
-                        // Message not complete and not in front of the buffer!
-                        // Copy last part to front for consume in future receive_cbk call!
-                        for (size_t i = 0; i < recv_buffer_size_; ++i) {
-                            recv_buffer_[i] = recv_buffer_[i + its_iteration_gap];
-                        }
-                    }
-                }
-            } while (recv_buffer_size_ > 0 && its_start == FOUND_MESSAGE);
+                on_message(its_host, &recv_buffer_[its_offset + sizeof(uint32_t)],
+                           its_frame_size);
+                its_offset += sizeof(uint32_t) + its_frame_size;
+            }
+
+            recv_buffer_size_ -= its_offset;
+            if (its_offset > 0 && recv_buffer_size_ > 0) {
+                // Move the incomplete frame to the front of the buffer
+                std::memmove(&recv_buffer_[0], &recv_buffer_[its_offset],
+                        recv_buffer_size_);
+            }
         }
 
         if (_error == boost::asio::error::misc_errors::eof) {
@@ -273,4 +266,51 @@ void local_server_endpoint_impl::connection::receive_cbk(
     }
 }
 
+void local_server_endpoint_impl::connection::on_message(
+        std::shared_ptr<endpoint_host> &_host,
+        const byte_t *_data, uint32_t _size) {
+#ifndef WIN32
+    if (_size >= VSOMEIP_COMMAND_HEADER_SIZE) {
+        byte_t its_command = _data[VSOMEIP_COMMAND_TYPE_POS];
+        if (its_command == VSOMEIP_SHM_ATTACH) {
+            std::string its_name(
+                    reinterpret_cast<const char *>(
+                            &_data[VSOMEIP_COMMAND_PAYLOAD_POS]),
+                    _size - VSOMEIP_COMMAND_HEADER_SIZE);
+            ring_ = local_shm_ring::open(its_name);
+            if (ring_) {
+                VSOMEIP_DEBUG << "Attached shared memory ring " << its_name;
+                // Mapped now, the name is no longer needed
+                ring_->unlink();
+                receive_ring(_host);
+            }
+            return;
+        } else if (its_command == VSOMEIP_SHM_NOTIFY) {
+            receive_ring(_host);
+            return;
+        }
+    }
+#endif
+    _host->on_message(_data, _size, server_);
+}
+
+void local_server_endpoint_impl::connection::receive_ring(
+        std::shared_ptr<endpoint_host> &_host) {
+#ifndef WIN32
+    if (!ring_)
+        return;
+
+    const byte_t *its_data;
+    std::uint32_t its_size;
+    do {
+        while (ring_->front(its_data, its_size)) {
+            _host->on_message(its_data, its_size, server_);
+            ring_->pop(its_size);
+        }
+    } while (!ring_->wait());
+#else
+    (void)_host;
+#endif
+}
+
 } // namespace vsomeip
@@ -0,0 +1,200 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef WIN32
+
+#include <chrono>
+#include <cstring>
+
+#include "../include/local_shm_client_endpoint_impl.hpp"
+#include "../include/local_shm_ring.hpp"
+#include "../../configuration/include/internal.hpp"
+#include "../../logging/include/logger.hpp"
+
+namespace vsomeip {
+
+local_shm_client_endpoint_impl::local_shm_client_endpoint_impl(
+        std::shared_ptr<endpoint_host> _host, endpoint_type _remote,
+        boost::asio::io_service &_io, std::uint32_t _max_message_size,
+        const std::string &_ring_name)
+    : local_client_endpoint_impl(_host, _remote, _io, _max_message_size),
+      ring_name_(_ring_name),
+      ring_size_(VSOMEIP_DEFAULT_SHM_RING_SIZE),
+      retry_timer_(_io) {
+    // A ring must be able to hold at least two messages of maximum size
+    while (ring_size_ < 2 * (_max_message_size + 2 * sizeof(uint32_t)))
+        ring_size_ <<= 1;
+}
+
+local_shm_client_endpoint_impl::~local_shm_client_endpoint_impl() {
+}
+
+bool local_shm_client_endpoint_impl::send(const uint8_t *_data,
+        uint32_t _size, bool _flush) {
+    bool must_notify(false);
+    {
+        std::lock_guard<std::mutex> its_lock(ring_mutex_);
+        if (!ring_) {
+            return local_client_endpoint_impl::send(_data, _size, _flush);
+        }
+
+        if (pending_.empty() && ring_->push(_data, _size)) {
+            must_notify = ring_->notify();
+        } else {
+            if (_size + 2 * sizeof(uint32_t) > (ring_->get_capacity() >> 1)) {
+                VSOMEIP_ERROR << "Message of size " << _size
+                        << " exceeds shared memory ring \""
+                        << ring_name_ << "\"";
+                return false;
+            }
+
+            pending_.push_back(
+                    std::make_shared<message_buffer_t>(_data, _data + _size));
+            if (pending_.size() == 1) {
+                retry_timer_.expires_from_now(
+                        std::chrono::milliseconds(VSOMEIP_DEFAULT_SHM_RETRY_TIMEOUT));
+                retry_timer_.async_wait(
+                        std::bind(
+                            &local_shm_client_endpoint_impl::retry_cbk,
+                            std::dynamic_pointer_cast<
+                                local_shm_client_endpoint_impl
+                            >(shared_from_this()),
+                            std::placeholders::_1));
+            }
+        }
+    }
+
+    if (must_notify)
+        send_notify();
+
+    return true;
+}
+
+bool local_shm_client_endpoint_impl::send(const message_buffer_ptr_t &_buffer,
+        bool _flush) {
+    {
+        std::lock_guard<std::mutex> its_lock(ring_mutex_);
+        if (!ring_) {
+            return local_client_endpoint_impl::send(_buffer, _flush);
+        }
+    }
+    return send(&(*_buffer)[0], uint32_t(_buffer->size()), _flush);
+}
+
+void local_shm_client_endpoint_impl::stop() {
+    {
+        std::lock_guard<std::mutex> its_lock(ring_mutex_);
+        retry_timer_.cancel();
+        pending_.clear();
+        if (ring_) {
+            ring_->unlink();
+            ring_.reset();
+        }
+    }
+    local_client_endpoint_impl::stop();
+}
+
+void local_shm_client_endpoint_impl::connect() {
+    {
+        std::lock_guard<std::mutex> its_lock(ring_mutex_);
+        retry_timer_.cancel();
+        pending_.clear();
+        if (ring_) {
+            ring_->unlink();
+            ring_.reset();
+        }
+    }
+
+    local_client_endpoint_impl::connect();
+
+    if (is_connected_) {
+        bool has_ring(false);
+        {
+            std::lock_guard<std::mutex> its_lock(ring_mutex_);
+            ring_ = local_shm_ring::create(ring_name_, ring_size_);
+            has_ring = (ring_ != nullptr);
+        }
+        if (has_ring) {
+            send_attach();
+        } else {
+            VSOMEIP_WARNING << "Falling back to socket transport for \""
+                    << ring_name_ << "\"";
+        }
+    }
+}
+
+void local_shm_client_endpoint_impl::send_attach() {
+    std::vector<byte_t> its_command(
+            VSOMEIP_COMMAND_HEADER_SIZE + ring_name_.length());
+    uint32_t its_size = uint32_t(ring_name_.length());
+
+    its_command[VSOMEIP_COMMAND_TYPE_POS] = VSOMEIP_SHM_ATTACH;
+    std::memcpy(&its_command[VSOMEIP_COMMAND_SIZE_POS_MIN], &its_size,
+            sizeof(its_size));
+    std::memcpy(&its_command[VSOMEIP_COMMAND_PAYLOAD_POS], ring_name_.c_str(),
+            ring_name_.length());
+
+    // The attach command must not be packed behind pending socket data
+    (void)flush();
+    (void)local_client_endpoint_impl::send(&its_command[0],
+            uint32_t(its_command.size()), true);
+}
+
+void local_shm_client_endpoint_impl::send_notify() {
+    byte_t its_command[VSOMEIP_COMMAND_HEADER_SIZE];
+    uint32_t its_size(0);
+
+    std::memset(its_command, 0, sizeof(its_command));
+    its_command[VSOMEIP_COMMAND_TYPE_POS] = VSOMEIP_SHM_NOTIFY;
+    std::memcpy(&its_command[VSOMEIP_COMMAND_SIZE_POS_MIN], &its_size,
+            sizeof(its_size));
+
+    (void)local_client_endpoint_impl::send(its_command, sizeof(its_command),
+            true);
+}
+
+void local_shm_client_endpoint_impl::retry_cbk(
+        boost::system::error_code const &_error) {
+    if (_error)
+        return;
+
+    bool must_notify(false);
+    {
+        std::lock_guard<std::mutex> its_lock(ring_mutex_);
+        if (!ring_)
+            return;
+
+        bool has_pushed(false);
+        while (!pending_.empty()) {
+            message_buffer_ptr_t its_buffer = pending_.front();
+            if (!ring_->push(&(*its_buffer)[0], uint32_t(its_buffer->size())))
+                break;
+            pending_.pop_front();
+            has_pushed = true;
+        }
+
+        if (has_pushed)
+            must_notify = ring_->notify();
+
+        if (!pending_.empty()) {
+            retry_timer_.expires_from_now(
+                    std::chrono::milliseconds(VSOMEIP_DEFAULT_SHM_RETRY_TIMEOUT));
+            retry_timer_.async_wait(
+                    std::bind(
+                        &local_shm_client_endpoint_impl::retry_cbk,
+                        std::dynamic_pointer_cast<
+                            local_shm_client_endpoint_impl
+                        >(shared_from_this()),
+                        std::placeholders::_1));
+        }
+    }
+
+    if (must_notify)
+        send_notify();
+}
+
+} // namespace vsomeip
+
+#endif // WIN32
@@ -0,0 +1,215 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef WIN32
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../include/local_shm_ring.hpp"
+#include "../../configuration/include/internal.hpp"
+#include "../../logging/include/logger.hpp"
+
+namespace vsomeip {
+
+std::shared_ptr<local_shm_ring> local_shm_ring::create(
+        const std::string &_name, std::uint32_t _capacity) {
+    std::shared_ptr<local_shm_ring> its_ring;
+
+    std::uint32_t its_capacity(64);
+    while (its_capacity < _capacity && its_capacity < 0x80000000)
+        its_capacity <<= 1;
+
+    std::size_t its_segment_size = sizeof(header) + its_capacity;
+
+    shm_unlink(_name.c_str());
+    int its_descriptor = shm_open(_name.c_str(), O_RDWR|O_CREAT|O_EXCL, 0660);
+    if (its_descriptor > -1) {
+        if (0 == ftruncate(its_descriptor, off_t(its_segment_size))) {
+            void *its_segment = mmap(0, its_segment_size,
+                                     PROT_READ | PROT_WRITE, MAP_SHARED,
+                                     its_descriptor, 0);
+            if (its_segment != MAP_FAILED) {
+                header *its_header = reinterpret_cast<header *>(its_segment);
+                its_header->head_ = 0;
+                its_header->tail_ = 0;
+                its_header->is_waiting_ = 1;
+                its_header->capacity_ = its_capacity;
+                its_ring = std::shared_ptr<local_shm_ring>(
+                        new local_shm_ring(_name, its_segment, its_segment_size));
+            }
+        }
+        close(its_descriptor);
+        if (!its_ring) {
+            shm_unlink(_name.c_str());
+        }
+    }
+
+    if (!its_ring) {
+        VSOMEIP_ERROR << "Creating shared memory ring \"" << _name
+                << "\" failed (" << std::strerror(errno) << ")";
+    }
+    return its_ring;
+}
+
+std::shared_ptr<local_shm_ring> local_shm_ring::open(const std::string &_name) {
+    std::shared_ptr<local_shm_ring> its_ring;
+
+    int its_descriptor = shm_open(_name.c_str(), O_RDWR, 0660);
+    if (its_descriptor > -1) {
+        struct stat its_stat;
+        if (0 == fstat(its_descriptor, &its_stat)
+                && std::size_t(its_stat.st_size) > sizeof(header)) {
+            std::size_t its_segment_size = std::size_t(its_stat.st_size);
+            void *its_segment = mmap(0, its_segment_size,
+                                     PROT_READ | PROT_WRITE, MAP_SHARED,
+                                     its_descriptor, 0);
+            if (its_segment != MAP_FAILED) {
+                header *its_header = reinterpret_cast<header *>(its_segment);
+                if (sizeof(header) + its_header->capacity_ == its_segment_size) {
+                    its_ring = std::shared_ptr<local_shm_ring>(
+                            new local_shm_ring(_name, its_segment, its_segment_size));
+                } else {
+                    munmap(its_segment, its_segment_size);
+                }
+            }
+        }
+        close(its_descriptor);
+    }
+
+    if (!its_ring) {
+        VSOMEIP_ERROR << "Opening shared memory ring \"" << _name
+                << "\" failed.";
+    }
+    return its_ring;
+}
+
+local_shm_ring::local_shm_ring(const std::string &_name, void *_segment,
+        std::size_t _segment_size)
+    : name_(_name), segment_(_segment), segment_size_(_segment_size),
+      header_(reinterpret_cast<header *>(_segment)),
+      data_(reinterpret_cast<byte_t *>(_segment) + sizeof(header)),
+      mask_(header_->capacity_ - 1) {
+}
+
+local_shm_ring::~local_shm_ring() {
+    munmap(segment_, segment_size_);
+}
+
+const std::string & local_shm_ring::get_name() const {
+    return name_;
+}
+
+std::uint32_t local_shm_ring::get_capacity() const {
+    return header_->capacity_;
+}
+
+std::uint32_t local_shm_ring::get_record_size(std::uint32_t _size) {
+    return ((_size + sizeof(std::uint32_t) + 3) & ~std::uint32_t(3));
+}
+
+bool local_shm_ring::push(const byte_t *_data, std::uint32_t _size) {
+    const std::uint32_t its_capacity = header_->capacity_;
+
+    // Records larger than half of the ring could starve when wrapping.
+    // Check the size first, as the record size wraps for huge sizes.
+    if (_size > (its_capacity >> 1))
+        return false;
+    const std::uint32_t its_record_size = get_record_size(_size);
+    if (its_record_size > (its_capacity >> 1))
+        return false;
+
+    std::uint64_t its_tail = header_->tail_.load(std::memory_order_relaxed);
+    std::uint64_t its_head = header_->head_.load(std::memory_order_acquire);
+
+    std::uint32_t its_offset = std::uint32_t(its_tail & mask_);
+    std::uint32_t its_padding(0);
+    if (its_offset + its_record_size > its_capacity)
+        its_padding = its_capacity - its_offset;
+
+    if (its_tail - its_head + its_padding + its_record_size > its_capacity)
+        return false;
+
+    if (its_padding > 0) {
+        const std::uint32_t its_marker = VSOMEIP_SHM_RING_PADDING;
+        std::memcpy(&data_[its_offset], &its_marker, sizeof(its_marker));
+        its_tail += its_padding;
+        its_offset = 0;
+    }
+
+    std::memcpy(&data_[its_offset], &_size, sizeof(_size));
+    std::memcpy(&data_[its_offset + sizeof(_size)], _data, _size);
+
+    header_->tail_.store(its_tail + its_record_size);
+    return true;
+}
+
+bool local_shm_ring::notify() {
+    return (0 != header_->is_waiting_.exchange(0));
+}
+
+void local_shm_ring::unlink() {
+    shm_unlink(name_.c_str());
+}
+
+bool local_shm_ring::front(const byte_t *&_data, std::uint32_t &_size) {
+    // The ring is shared with another process, so nothing read from it is
+    // trusted. The capacity is taken from the size checked on mapping.
+    const std::uint32_t its_capacity = mask_ + 1;
+
+    std::uint64_t its_head = header_->head_.load(std::memory_order_relaxed);
+    std::uint64_t its_tail = header_->tail_.load(std::memory_order_acquire);
+
+    while (its_head != its_tail) {
+        std::uint32_t its_offset = std::uint32_t(its_head & mask_);
+        std::uint32_t its_size;
+        std::memcpy(&its_size, &data_[its_offset], sizeof(its_size));
+        if (its_size == VSOMEIP_SHM_RING_PADDING) {
+            its_head += (its_capacity - its_offset);
+            header_->head_.store(its_head, std::memory_order_release);
+            continue;
+        }
+
+        // Reject the length before computing the record size from it, which
+        // would wrap for lengths close to 4 GiB
+        if (its_size > its_capacity - its_offset - sizeof(its_size)
+                || its_offset + get_record_size(its_size) > its_capacity) {
+            VSOMEIP_ERROR << "Shared memory ring \"" << name_
+                    << "\" is corrupted.";
+            header_->head_.store(its_tail, std::memory_order_release);
+            return false;
+        }
+
+        _data = &data_[its_offset + sizeof(its_size)];
+        _size = its_size;
+        return true;
+    }
+
+    return false;
+}
+
+void local_shm_ring::pop(std::uint32_t _size) {
+    std::uint64_t its_head = header_->head_.load(std::memory_order_relaxed);
+    header_->head_.store(its_head + get_record_size(_size),
+            std::memory_order_release);
+}
+
+bool local_shm_ring::wait() {
+    header_->is_waiting_.store(1);
+    if (header_->tail_.load() != header_->head_.load(std::memory_order_relaxed)) {
+        header_->is_waiting_.store(0);
+        return false;
+    }
+    return true;
+}
+
+} // namespace vsomeip
+
+#endif // WIN32
@@ -26,7 +26,9 @@ server_endpoint_impl<Protocol, MaxBufferSize>::server_endpoint_impl(
         std::shared_ptr<endpoint_host> _host, endpoint_type _local,
         boost::asio::io_service &_io, std::uint32_t _max_message_size)
     : endpoint_impl<MaxBufferSize>(_host, _io, _max_message_size),
-      flush_timer_(_io), local_(_local) {
+      flush_wheel_(std::chrono::milliseconds(VSOMEIP_DEFAULT_FLUSH_TICK),
+              VSOMEIP_DEFAULT_FLUSH_WHEEL_SIZE),
+      flush_timer_(_io), is_flush_timer_running_(false), local_(_local) {
 }
 
 template<typename Protocol, int MaxBufferSize>
@@ -88,6 +90,44 @@ bool server_endpoint_impl<Protocol, MaxBufferSize>::send(const uint8_t *_data,
     return is_valid_target;
 }
 
+template<typename Protocol, int MaxBufferSize>
+bool server_endpoint_impl<Protocol, MaxBufferSize>::send(
+        const message_buffer_ptr_t &_buffer, bool _flush) {
+    return send(&(*_buffer)[0], uint32_t(_buffer->size()), _flush);
+}
+
+template<typename Protocol, int MaxBufferSize>
+bool server_endpoint_impl<Protocol, MaxBufferSize>::send_intern(
+        endpoint_type _target, const message_buffer_ptr_t &_buffer,
+        bool _flush) {
+    std::lock_guard<std::mutex> its_lock(mutex_);
+
+    auto found_packetizer = packetizer_.find(_target);
+    if (!_flush
+            || (found_packetizer != packetizer_.end()
+                    && !found_packetizer->second->empty())) {
+        return send_intern(_target, &(*_buffer)[0],
+                uint32_t(_buffer->size()), _flush);
+    }
+
+    // Nothing to pack the buffer with --> queue it without copying
+    queue_iterator_type target_queue_iterator = queues_.find(_target);
+    if (target_queue_iterator == queues_.end()) {
+        target_queue_iterator = queues_.insert(queues_.begin(),
+                                    std::make_pair(
+                                        _target,
+                                        std::deque<message_buffer_ptr_t>()
+                                    ));
+    }
+
+    target_queue_iterator->second.push_back(_buffer);
+    if (target_queue_iterator->second.size() == 1) { // no writing in progress
+        send_queued(target_queue_iterator);
+    }
+
+    return true;
+}
+
 template<typename Protocol, int MaxBufferSize>
 bool server_endpoint_impl<Protocol, MaxBufferSize>::send_intern(
         endpoint_type _target, const byte_t *_data, uint32_t _size,
@@ -101,7 +141,7 @@ bool server_endpoint_impl<Protocol, MaxBufferSize>::send_intern(
     if (found_packetizer != packetizer_.end()) {
         target_packetizer = found_packetizer->second;
     } else {
-        target_packetizer = std::make_shared<message_buffer_t>();
+        target_packetizer = this->create_packetizer();
         packetizer_.insert(std::make_pair(_target, target_packetizer));
     }
 
@@ -114,30 +154,38 @@ bool server_endpoint_impl<Protocol, MaxBufferSize>::send_intern(
                                     ));
     }
 
-    // TODO compare against value from configuration here
+    std::chrono::milliseconds its_max_delay(VSOMEIP_DEFAULT_FLUSH_TIMEOUT);
+    std::uint32_t its_max_bytes(endpoint_impl<MaxBufferSize>::max_message_size_);
+    if (_size > VSOMEIP_SERVICE_POS_MAX) {
+        service_t its_service = VSOMEIP_BYTES_TO_WORD(
+                _data[VSOMEIP_SERVICE_POS_MIN], _data[VSOMEIP_SERVICE_POS_MAX]);
+        auto found_policy = flush_policies_.find(its_service);
+        if (found_policy != flush_policies_.end()) {
+            its_max_delay = found_policy->second.max_delay_;
+            if (found_policy->second.max_bytes_ > 0
+                    && found_policy->second.max_bytes_ < its_max_bytes)
+                its_max_bytes = found_policy->second.max_bytes_;
+        }
+    }
+
     if (target_packetizer->size() + _size > endpoint_impl<MaxBufferSize>::max_message_size_) {
         target_queue_iterator->second.push_back(target_packetizer);
         is_flushing = true;
-        packetizer_[_target] = std::make_shared<message_buffer_t>();
+        flush_wheel_.cancel(_target);
+        target_packetizer = this->create_packetizer();
+        packetizer_[_target] = target_packetizer;
     }
 
     target_packetizer->insert(target_packetizer->end(), _data, _data + _size);
 
-    if (_flush) {
-        flush_timer_.cancel();
+    if (_flush || target_packetizer->size() >= its_max_bytes) {
         target_queue_iterator->second.push_back(target_packetizer);
         is_flushing = true;
-        packetizer_[_target] = std::make_shared<message_buffer_t>();
+        flush_wheel_.cancel(_target);
+        packetizer_[_target] = this->create_packetizer();
     } else {
-        std::chrono::milliseconds flush_timeout(VSOMEIP_DEFAULT_FLUSH_TIMEOUT);
-        flush_timer_.expires_from_now(flush_timeout); // TODO: use configured value
-        flush_timer_.async_wait(
-                std::bind(&server_endpoint_impl<
-                              Protocol, MaxBufferSize
-                          >::flush_cbk,
-                          this->shared_from_this(),
-                          _target,
-                          std::placeholders::_1));
+        flush_wheel_.schedule(_target, its_max_delay);
+        start_flush_timer();
     }
 
     if (is_flushing && target_queue_iterator->second.size() == 1) { // no writing in progress
@@ -161,6 +209,53 @@ bool server_endpoint_impl<Protocol, MaxBufferSize>::flush(
     return is_flushed;
 }
 
+template<typename Protocol, int MaxBufferSize>
+void server_endpoint_impl<Protocol, MaxBufferSize>::set_flush_policy(
+        service_t _service, std::uint32_t _max_delay, std::uint32_t _max_bytes) {
+    std::lock_guard<std::mutex> its_lock(mutex_);
+    flush_policy &its_policy = flush_policies_[_service];
+    its_policy.max_delay_ = std::chrono::milliseconds(_max_delay);
+    its_policy.max_bytes_ = _max_bytes;
+}
+
+template<typename Protocol, int MaxBufferSize>
+void server_endpoint_impl<Protocol, MaxBufferSize>::start_flush_timer() {
+    if (!is_flush_timer_running_) {
+        is_flush_timer_running_ = true;
+        flush_timer_.expires_from_now(flush_wheel_.get_tick());
+        flush_timer_.async_wait(
+                std::bind(&server_endpoint_impl<
+                              Protocol, MaxBufferSize
+                          >::flush_cbk,
+                          this->shared_from_this(),
+                          std::placeholders::_1));
+    }
+}
+
+template<typename Protocol, int MaxBufferSize>
+void server_endpoint_impl<Protocol, MaxBufferSize>::flush_packetizer(
+        endpoint_type _target) {
+    auto found_packetizer = packetizer_.find(_target);
+    if (found_packetizer == packetizer_.end()
+            || found_packetizer->second->empty())
+        return;
+
+    queue_iterator_type target_queue_iterator = queues_.find(_target);
+    if (target_queue_iterator == queues_.end()) {
+        target_queue_iterator = queues_.insert(queues_.begin(),
+                                    std::make_pair(
+                                        _target,
+                                        std::deque<message_buffer_ptr_t>()
+                                    ));
+    }
+
+    target_queue_iterator->second.push_back(found_packetizer->second);
+    found_packetizer->second = this->create_packetizer();
+    if (target_queue_iterator->second.size() == 1) { // no writing in progress
+        send_queued(target_queue_iterator);
+    }
+}
+
 template<typename Protocol, int MaxBufferSize>
 void server_endpoint_impl<Protocol, MaxBufferSize>::connect_cbk(
         boost::system::error_code const &_error) {
@@ -175,7 +270,9 @@ void server_endpoint_impl<Protocol, MaxBufferSize>::send_cbk(
 
     if (!_error) {
         std::lock_guard<std::mutex> its_lock(mutex_);
+        message_buffer_ptr_t its_buffer = _queue_iterator->second.front();
         _queue_iterator->second.pop_front();
+        this->recycle_packetizer(its_buffer);
         if (_queue_iterator->second.size() > 0) {
             send_queued(_queue_iterator);
         }
@@ -184,9 +281,30 @@ void server_endpoint_impl<Protocol, MaxBufferSize>::send_cbk(
 
 template<typename Protocol, int MaxBufferSize>
 void server_endpoint_impl<Protocol, MaxBufferSize>::flush_cbk(
-        endpoint_type _target, const boost::system::error_code &_error_code) {
-    if (!_error_code) {
-        (void) flush(_target);
+        const boost::system::error_code &_error_code) {
+    std::lock_guard<std::mutex> its_lock(mutex_);
+    if (_error_code) {
+        is_flush_timer_running_ = false;
+        return;
+    }
+
+    std::vector<endpoint_type> its_expired;
+    flush_wheel_.advance(its_expired);
+    for (auto &its_target : its_expired)
+        flush_packetizer(its_target);
+
+    if (flush_wheel_.empty()) {
+        is_flush_timer_running_ = false;
+    } else {
+        // Continue from the previous expiry to not accumulate any drift
+        flush_timer_.expires_at(
+                flush_timer_.expires_at() + flush_wheel_.get_tick());
+        flush_timer_.async_wait(
+                std::bind(&server_endpoint_impl<
+                              Protocol, MaxBufferSize
+                          >::flush_cbk,
+                          this->shared_from_this(),
+                          std::placeholders::_1));
     }
 }
 
@@ -3,6 +3,7 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <cstring>
 #include <iomanip>
 
 #include <boost/asio/write.hpp>
@@ -23,7 +24,8 @@ tcp_client_endpoint_impl::tcp_client_endpoint_impl(
         std::shared_ptr< endpoint_host > _host, endpoint_type _remote,
         boost::asio::io_service &_io, std::uint32_t _max_message_size)
     : tcp_client_endpoint_base_impl(_host, _remote, _io, _max_message_size),
-      recv_buffer_(_max_message_size, 0),
+      recv_buffer_(_max_message_size < VSOMEIP_MAX_TCP_MESSAGE_SIZE ?
+              _max_message_size : VSOMEIP_MAX_TCP_MESSAGE_SIZE, 0),
       recv_buffer_size_(0) {
     is_supporting_magic_cookies_ = true;
 }
@@ -56,11 +58,11 @@ void tcp_client_endpoint_impl::connect() {
 }
 
 void tcp_client_endpoint_impl::receive() {
-    if (recv_buffer_size_ == max_message_size_) {
+    if (recv_buffer_size_ == recv_buffer_.size()) {
         // Overrun -> Reset buffer
         recv_buffer_size_ = 0;
     }
-    size_t buffer_size = max_message_size_ - recv_buffer_size_;
+    size_t buffer_size = recv_buffer_.size() - recv_buffer_size_;
     socket_.async_receive(
         boost::asio::buffer(&recv_buffer_[recv_buffer_size_], buffer_size),
         std::bind(
@@ -73,10 +75,15 @@ void tcp_client_endpoint_impl::receive() {
 }
 
 void tcp_client_endpoint_impl::send_queued() {
-    message_buffer_ptr_t its_buffer = queue_.front();
+    message_buffer_ptr_t &its_buffer = queue_.front();
 
+    // The magic cookie is written as separate segment in front of the
+    // (possibly shared) packet instead of being copied into it.
+    boost::array<boost::asio::const_buffer, 2> its_segments = {{
+        boost::asio::const_buffer(), boost::asio::buffer(*its_buffer)
+    }};
     if (has_enabled_magic_cookies_)
-        send_magic_cookie(its_buffer);
+        its_segments[0] = get_magic_cookie(its_buffer);
 
 #if 0
     std::stringstream msg;
@@ -90,7 +97,7 @@ void tcp_client_endpoint_impl::send_queued() {
 
     boost::asio::async_write(
         socket_,
-        boost::asio::buffer(*its_buffer),
+        its_segments,
         std::bind(
             &tcp_client_endpoint_base_impl::send_cbk,
             shared_from_this(),
@@ -118,21 +125,44 @@ bool tcp_client_endpoint_impl::is_reliable() const {
   return true;
 }
 
+void tcp_client_endpoint_impl::adjust_receive_buffer() {
+    // Messages that do not fit into the default buffer are received into
+    // a buffer of their size which is released once they have been read.
+    size_t its_default_size = max_message_size_;
+    if (its_default_size > VSOMEIP_MAX_TCP_MESSAGE_SIZE)
+        its_default_size = VSOMEIP_MAX_TCP_MESSAGE_SIZE;
+
+    size_t its_required_size = utility::get_message_size(&recv_buffer_[0],
+            uint32_t(recv_buffer_size_));
+    if (its_required_size > max_message_size_)
+        its_required_size = 0; // will be dropped
+    if (its_required_size < recv_buffer_size_)
+        its_required_size = recv_buffer_size_;
+    if (its_required_size < its_default_size)
+        its_required_size = its_default_size;
+
+    if (its_required_size > recv_buffer_.size()) {
+        recv_buffer_.resize(its_required_size, 0);
+    } else if (its_required_size < recv_buffer_.size()) {
+        receive_buffer_t its_buffer(its_required_size, 0);
+        if (recv_buffer_size_)
+            std::memcpy(&its_buffer[0], &recv_buffer_[0], recv_buffer_size_);
+        recv_buffer_.swap(its_buffer);
+    }
+}
+
 bool tcp_client_endpoint_impl::is_magic_cookie(size_t _offset) const {
     return (0 == std::memcmp(SERVICE_COOKIE, &recv_buffer_[_offset], sizeof(SERVICE_COOKIE)));
 }
 
-void tcp_client_endpoint_impl::send_magic_cookie(message_buffer_ptr_t &_buffer) {
+boost::asio::const_buffer tcp_client_endpoint_impl::get_magic_cookie(
+        const message_buffer_ptr_t &_buffer) const {
     if (VSOMEIP_MAX_TCP_MESSAGE_SIZE - _buffer->size() >=
         VSOMEIP_SOMEIP_HEADER_SIZE + VSOMEIP_SOMEIP_MAGIC_COOKIE_SIZE) {
-        _buffer->insert(
-            _buffer->begin(),
-            CLIENT_COOKIE,
-            CLIENT_COOKIE + sizeof(CLIENT_COOKIE)
-        );
-    } else {
-        VSOMEIP_WARNING << "Packet full. Cannot insert magic cookie!";
+        return boost::asio::buffer(CLIENT_COOKIE);
     }
+    VSOMEIP_WARNING << "Packet full. Cannot insert magic cookie!";
+    return boost::asio::const_buffer();
 }
 
 void tcp_client_endpoint_impl::receive_cbk(
@@ -164,8 +194,14 @@ void tcp_client_endpoint_impl::receive_cbk(
                         has_enabled_magic_cookies_ = true;
                     } else {
                         if (has_enabled_magic_cookies_) {
+                            // Only cookies within the current message matter
+                            size_t its_scan_size = current_message_size
+                                    + VSOMEIP_SOMEIP_HEADER_SIZE
+                                    + VSOMEIP_SOMEIP_MAGIC_COOKIE_SIZE;
+                            if (its_scan_size > recv_buffer_size_)
+                                its_scan_size = recv_buffer_size_;
                             uint32_t its_offset = find_magic_cookie(&recv_buffer_[its_iteration_gap],
-                                    (uint32_t) recv_buffer_size_);
+                                    its_scan_size);
                             if (its_offset < current_message_size) {
                                 VSOMEIP_ERROR << "Message includes Magic Cookie. Ignoring it.";
                                 current_message_size = its_offset;
@@ -200,12 +236,12 @@ void tcp_client_endpoint_impl::receive_cbk(
                     recv_buffer_size_ = 0;
                 }
             } while (has_full_message && recv_buffer_size_);
-            if (its_iteration_gap) {
+            if (its_iteration_gap && recv_buffer_size_) {
                 // Copy incomplete message to front for next receive_cbk iteration
-                for (size_t i = 0; i < recv_buffer_size_; ++i) {
-                    recv_buffer_[i] = recv_buffer_[i + its_iteration_gap];
-                }
+                std::memmove(&recv_buffer_[0], &recv_buffer_[its_iteration_gap],
+                        recv_buffer_size_);
             }
+            adjust_receive_buffer();
             restart();
         } else {
             if (socket_.is_open()) {
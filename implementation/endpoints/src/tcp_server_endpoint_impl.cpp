@@ -3,6 +3,7 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <cstring>
 #include <iomanip>
 
 #include <boost/asio/write.hpp>
@@ -46,6 +47,7 @@ void tcp_server_endpoint_impl::start() {
 }
 
 void tcp_server_endpoint_impl::stop() {
+    std::lock_guard<std::mutex> its_lock(mutex_);
     for (auto& i : connections_)
         i.second->stop();
     acceptor_.close();
@@ -55,10 +57,18 @@ bool tcp_server_endpoint_impl::send_to(
         const std::shared_ptr<endpoint_definition> _target,
         const byte_t *_data,
         uint32_t _size, bool _flush) {
+    std::lock_guard<std::mutex> its_lock(mutex_);
     endpoint_type its_target(_target->get_address(), _target->get_port());
     return send_intern(its_target, _data, _size, _flush);
 }
 
+bool tcp_server_endpoint_impl::send_to(
+        const std::shared_ptr<endpoint_definition> _target,
+        const message_buffer_ptr_t &_buffer, bool _flush) {
+    endpoint_type its_target(_target->get_address(), _target->get_port());
+    return send_intern(its_target, _buffer, _flush);
+}
+
 void tcp_server_endpoint_impl::send_queued(queue_iterator_type _queue_iterator) {
     auto connection_iterator = connections_.find(_queue_iterator->first);
     if (connection_iterator != connections_.end())
@@ -102,7 +112,10 @@ void tcp_server_endpoint_impl::accept_cbk(connection::ptr _connection,
         socket_type &new_connection_socket = _connection->get_socket();
         endpoint_type remote = new_connection_socket.remote_endpoint();
 
-        connections_[remote] = _connection;
+        {
+            std::lock_guard<std::mutex> its_lock(mutex_);
+            connections_[remote] = _connection;
+        }
         _connection->start();
 
         start();
@@ -113,6 +126,17 @@ unsigned short tcp_server_endpoint_impl::get_local_port() const {
     return acceptor_.local_endpoint().port();
 }
 
+unsigned short tcp_server_endpoint_impl::get_remote_port() const {
+    if (current_) {
+        boost::system::error_code its_error;
+        tcp_server_endpoint_impl::endpoint_type its_endpoint =
+                current_->get_socket().remote_endpoint(its_error);
+        if (!its_error)
+            return its_endpoint.port();
+    }
+    return 0;
+}
+
 bool tcp_server_endpoint_impl::is_reliable() const {
     return true;
 }
@@ -124,7 +148,8 @@ tcp_server_endpoint_impl::connection::connection(
         tcp_server_endpoint_impl *_server, std::uint32_t _max_message_size) :
         socket_(_server->service_), server_(_server),
         max_message_size_(_max_message_size),
-        recv_buffer_(_max_message_size, 0),
+        recv_buffer_(_max_message_size < VSOMEIP_MAX_TCP_MESSAGE_SIZE ?
+                _max_message_size : VSOMEIP_MAX_TCP_MESSAGE_SIZE, 0),
         recv_buffer_size_(0) {
 }
 
@@ -146,13 +171,13 @@ void tcp_server_endpoint_impl::connection::start() {
 }
 
 void tcp_server_endpoint_impl::connection::receive() {
-    if (recv_buffer_size_ == max_message_size_) {
+    if (recv_buffer_size_ == recv_buffer_.size()) {
         // Overrun -> Reset buffer
         recv_buffer_size_ = 0;
     }
     std::lock_guard<std::mutex> its_lock(stop_mutex_);
     if(socket_.is_open()) {
-        size_t buffer_size = max_message_size_ - recv_buffer_size_;
+        size_t buffer_size = recv_buffer_.size() - recv_buffer_size_;
         socket_.async_receive(boost::asio::buffer(&recv_buffer_[recv_buffer_size_], buffer_size),
                 std::bind(&tcp_server_endpoint_impl::connection::receive_cbk,
                         shared_from_this(), std::placeholders::_1,
@@ -170,24 +195,54 @@ void tcp_server_endpoint_impl::connection::stop() {
 
 void tcp_server_endpoint_impl::connection::send_queued(
         queue_iterator_type _queue_iterator) {
-    message_buffer_ptr_t its_buffer = _queue_iterator->second.front();
+    message_buffer_ptr_t &its_buffer = _queue_iterator->second.front();
 
+    boost::array<boost::asio::const_buffer, 2> its_segments = {{
+        boost::asio::const_buffer(), boost::asio::buffer(*its_buffer)
+    }};
     if (server_->has_enabled_magic_cookies_)
-        send_magic_cookie(its_buffer);
+        its_segments[0] = get_magic_cookie(its_buffer);
 
-    boost::asio::async_write(socket_, boost::asio::buffer(*its_buffer),
+    boost::asio::async_write(socket_, its_segments,
             std::bind(&tcp_server_endpoint_base_impl::send_cbk,
                       server_->shared_from_this(),
                       _queue_iterator, std::placeholders::_1,
                       std::placeholders::_2));
 }
 
-void tcp_server_endpoint_impl::connection::send_magic_cookie(
-        message_buffer_ptr_t &_buffer) {
+boost::asio::const_buffer
+tcp_server_endpoint_impl::connection::get_magic_cookie(
+        const message_buffer_ptr_t &_buffer) const {
     if (VSOMEIP_MAX_TCP_MESSAGE_SIZE - _buffer->size() >=
     VSOMEIP_SOMEIP_HEADER_SIZE + VSOMEIP_SOMEIP_MAGIC_COOKIE_SIZE) {
-        _buffer->insert(_buffer->begin(), SERVICE_COOKIE,
-                SERVICE_COOKIE + sizeof(SERVICE_COOKIE));
+        return boost::asio::buffer(SERVICE_COOKIE);
+    }
+    return boost::asio::const_buffer();
+}
+
+void tcp_server_endpoint_impl::connection::adjust_receive_buffer() {
+    // Messages that do not fit into the default buffer are received into
+    // a buffer of their size which is released once they have been read.
+    size_t its_default_size = max_message_size_;
+    if (its_default_size > VSOMEIP_MAX_TCP_MESSAGE_SIZE)
+        its_default_size = VSOMEIP_MAX_TCP_MESSAGE_SIZE;
+
+    size_t its_required_size = utility::get_message_size(&recv_buffer_[0],
+            uint32_t(recv_buffer_size_));
+    if (its_required_size > max_message_size_)
+        its_required_size = 0; // will be dropped
+    if (its_required_size < recv_buffer_size_)
+        its_required_size = recv_buffer_size_;
+    if (its_required_size < its_default_size)
+        its_required_size = its_default_size;
+
+    if (its_required_size > recv_buffer_.size()) {
+        recv_buffer_.resize(its_required_size, 0);
+    } else if (its_required_size < recv_buffer_.size()) {
+        receive_buffer_t its_buffer(its_required_size, 0);
+        if (recv_buffer_size_)
+            std::memcpy(&its_buffer[0], &recv_buffer_[0], recv_buffer_size_);
+        recv_buffer_.swap(its_buffer);
     }
 }
 
@@ -225,9 +280,15 @@ void tcp_server_endpoint_impl::connection::receive_cbk(
                         server_->has_enabled_magic_cookies_ = true;
                     } else {
                         if (server_->has_enabled_magic_cookies_) {
+                            // Only cookies within the current message matter
+                            size_t its_scan_size = current_message_size
+                                    + VSOMEIP_SOMEIP_HEADER_SIZE
+                                    + VSOMEIP_SOMEIP_MAGIC_COOKIE_SIZE;
+                            if (its_scan_size > recv_buffer_size_)
+                                its_scan_size = recv_buffer_size_;
                             uint32_t its_offset
                                 = server_->find_magic_cookie(&recv_buffer_[its_iteration_gap],
-                                        recv_buffer_size_);
+                                        its_scan_size);
                             if (its_offset < current_message_size) {
                                 VSOMEIP_ERROR << "Detected Magic Cookie within message data. Resyncing.";
                                 if (!is_magic_cookie(its_iteration_gap)) {
@@ -240,23 +301,30 @@ void tcp_server_endpoint_impl::connection::receive_cbk(
                         }
                     }
                     if (needs_forwarding) {
-                        if (utility::is_request(recv_buffer_[VSOMEIP_MESSAGE_TYPE_POS])) {
+                        if (utility::is_request(recv_buffer_[
+                                its_iteration_gap + VSOMEIP_MESSAGE_TYPE_POS])) {
                             client_t its_client;
                             std::memcpy(&its_client,
-                                &recv_buffer_[VSOMEIP_CLIENT_POS_MIN],
+                                &recv_buffer_[its_iteration_gap + VSOMEIP_CLIENT_POS_MIN],
                                 sizeof(client_t));
                             session_t its_session;
                             std::memcpy(&its_session,
-                                &recv_buffer_[VSOMEIP_SESSION_POS_MIN],
+                                &recv_buffer_[its_iteration_gap + VSOMEIP_SESSION_POS_MIN],
                                 sizeof(session_t));
+                            endpoint_type its_remote;
+                            bool is_open(false);
                             {
                                 std::lock_guard<std::mutex> its_lock(stop_mutex_);
                                 if (socket_.is_open()) {
-                                    server_->clients_[its_client][its_session] =
-                                            socket_.remote_endpoint();
+                                    its_remote = socket_.remote_endpoint();
                                     server_->current_ = this;
+                                    is_open = true;
                                 }
                             }
+                            if (is_open) {
+                                std::lock_guard<std::mutex> its_lock(server_->mutex_);
+                                server_->clients_[its_client][its_session] = its_remote;
+                            }
                         }
                         if (!server_->has_enabled_magic_cookies_) {
                             its_host->on_message(&recv_buffer_[its_iteration_gap],
@@ -296,12 +364,12 @@ void tcp_server_endpoint_impl::connection::receive_cbk(
                     recv_buffer_size_ = 0;
                 }
             } while (has_full_message && recv_buffer_size_);
-            if (its_iteration_gap) {
+            if (its_iteration_gap && recv_buffer_size_) {
                 // Copy incomplete message to front for next receive_cbk iteration
-                for (size_t i = 0; i < recv_buffer_size_; ++i) {
-                    recv_buffer_[i] = recv_buffer_[i + its_iteration_gap];
-                }
+                std::memmove(&recv_buffer_[0], &recv_buffer_[its_iteration_gap],
+                        recv_buffer_size_);
             }
+            adjust_receive_buffer();
             receive();
         }
     }
@@ -309,6 +377,7 @@ void tcp_server_endpoint_impl::connection::receive_cbk(
 
 client_t tcp_server_endpoint_impl::get_client(std::shared_ptr<endpoint_definition> _endpoint) {
     endpoint_type endpoint(_endpoint->get_address(), _endpoint->get_port());
+    std::lock_guard<std::mutex> its_lock(mutex_);
     auto its_remote = connections_.find(endpoint);
     if (its_remote != connections_.end()) {
         return its_remote->second->get_client(endpoint);
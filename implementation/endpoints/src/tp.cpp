@@ -0,0 +1,255 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstring>
+#include <iomanip>
+#include <iterator>
+
+#include <vsomeip/defines.hpp>
+
+#include "../include/tp.hpp"
+#include "../../configuration/include/internal.hpp"
+#include "../../logging/include/logger.hpp"
+#include "../../utility/include/byteorder.hpp"
+
+namespace vsomeip {
+
+tp::tp() {
+}
+
+void tp::set_policy(service_t _service, std::uint32_t _max_segment_length,
+        std::uint32_t _max_message_size, std::uint32_t _timeout) {
+    std::lock_guard<std::mutex> its_lock(mutex_);
+    policy &its_policy = policies_[_service];
+    // All segments except the last one must carry a multiple of 16 bytes
+    its_policy.max_segment_length_ = (_max_segment_length & ~0xFu);
+    its_policy.max_message_size_ = _max_message_size;
+    its_policy.timeout_ = std::chrono::milliseconds(_timeout);
+}
+
+bool tp::segment(const byte_t *_data, std::uint32_t _size,
+        std::uint32_t _max_size,
+        std::vector<message_buffer_ptr_t> &_segments) const {
+    if (_size <= VSOMEIP_PAYLOAD_POS)
+        return false;
+
+    std::uint32_t its_length(0);
+    {
+        service_t its_service = VSOMEIP_BYTES_TO_WORD(
+                _data[VSOMEIP_SERVICE_POS_MIN], _data[VSOMEIP_SERVICE_POS_MAX]);
+        std::lock_guard<std::mutex> its_lock(mutex_);
+        auto found_policy = policies_.find(its_service);
+        if (found_policy == policies_.end())
+            return false;
+        its_length = found_policy->second.max_segment_length_;
+    }
+
+    const std::uint32_t its_overhead
+        = VSOMEIP_PAYLOAD_POS + VSOMEIP_TP_HEADER_SIZE;
+    if (its_overhead + its_length > _max_size)
+        its_length = ((_max_size - its_overhead) & ~0xFu);
+    if (0 == its_length)
+        return false;
+
+    const std::uint32_t its_payload_size = _size - VSOMEIP_PAYLOAD_POS;
+    for (std::uint32_t its_offset = 0; its_offset < its_payload_size;
+            its_offset += its_length) {
+        std::uint32_t its_segment_length = its_payload_size - its_offset;
+        bool has_more(its_segment_length > its_length);
+        if (has_more)
+            its_segment_length = its_length;
+
+        message_buffer_ptr_t its_segment
+            = std::make_shared<message_buffer_t>(
+                    its_overhead + its_segment_length);
+        byte_t *its_data = &(*its_segment)[0];
+        std::memcpy(its_data, _data, VSOMEIP_PAYLOAD_POS);
+
+        std::uint32_t its_message_length = its_overhead + its_segment_length
+                - VSOMEIP_SOMEIP_HEADER_SIZE;
+        its_data[VSOMEIP_LENGTH_POS_MIN] = VSOMEIP_LONG_BYTE3(its_message_length);
+        its_data[VSOMEIP_LENGTH_POS_MIN + 1] = VSOMEIP_LONG_BYTE2(its_message_length);
+        its_data[VSOMEIP_LENGTH_POS_MIN + 2] = VSOMEIP_LONG_BYTE1(its_message_length);
+        its_data[VSOMEIP_LENGTH_POS_MAX] = VSOMEIP_LONG_BYTE0(its_message_length);
+        its_data[VSOMEIP_MESSAGE_TYPE_POS] |= VSOMEIP_TP_FLAG;
+
+        // The offset is a multiple of 16, it is transported in 16 byte
+        // units within the upper 28 bits of the TP header.
+        std::uint32_t its_header = (its_offset | (has_more ? 0x1 : 0x0));
+        its_data[VSOMEIP_PAYLOAD_POS] = VSOMEIP_LONG_BYTE3(its_header);
+        its_data[VSOMEIP_PAYLOAD_POS + 1] = VSOMEIP_LONG_BYTE2(its_header);
+        its_data[VSOMEIP_PAYLOAD_POS + 2] = VSOMEIP_LONG_BYTE1(its_header);
+        its_data[VSOMEIP_PAYLOAD_POS + 3] = VSOMEIP_LONG_BYTE0(its_header);
+
+        std::memcpy(&its_data[its_overhead],
+                &_data[VSOMEIP_PAYLOAD_POS + its_offset], its_segment_length);
+        _segments.push_back(its_segment);
+    }
+
+    return true;
+}
+
+message_buffer_ptr_t tp::reassemble(const endpoint_type &_sender,
+        const byte_t *_data, std::uint32_t _size) {
+    message_buffer_ptr_t its_message;
+    if (_size < VSOMEIP_PAYLOAD_POS + VSOMEIP_TP_HEADER_SIZE) {
+        VSOMEIP_ERROR << "Received a SOME/IP-TP segment without TP header";
+        return its_message;
+    }
+
+    service_t its_service = VSOMEIP_BYTES_TO_WORD(
+            _data[VSOMEIP_SERVICE_POS_MIN], _data[VSOMEIP_SERVICE_POS_MAX]);
+    std::uint32_t its_header = VSOMEIP_BYTES_TO_LONG(
+            _data[VSOMEIP_PAYLOAD_POS], _data[VSOMEIP_PAYLOAD_POS + 1],
+            _data[VSOMEIP_PAYLOAD_POS + 2], _data[VSOMEIP_PAYLOAD_POS + 3]);
+    std::uint32_t its_offset = (its_header & ~0xFu);
+    bool has_more = (0 != (its_header & 0x1));
+    std::uint32_t its_length
+        = _size - VSOMEIP_PAYLOAD_POS - VSOMEIP_TP_HEADER_SIZE;
+
+    std::lock_guard<std::mutex> its_lock(mutex_);
+    auto found_policy = policies_.find(its_service);
+    if (found_policy == policies_.end()) {
+        VSOMEIP_WARNING << "Dropping SOME/IP-TP segment of service "
+                << std::hex << std::setw(4) << std::setfill('0')
+                << its_service << " that does not use SOME/IP-TP";
+        return its_message;
+    }
+    const policy &its_policy = found_policy->second;
+
+    std::chrono::steady_clock::time_point its_now
+        = std::chrono::steady_clock::now();
+    expire(its_now);
+
+    message_key_t its_key(_sender,
+            (std::uint64_t(VSOMEIP_BYTES_TO_LONG(
+                    _data[VSOMEIP_SERVICE_POS_MIN], _data[VSOMEIP_SERVICE_POS_MAX],
+                    _data[VSOMEIP_METHOD_POS_MIN], _data[VSOMEIP_METHOD_POS_MAX])) << 32)
+            | std::uint64_t(VSOMEIP_BYTES_TO_LONG(
+                    _data[VSOMEIP_CLIENT_POS_MIN], _data[VSOMEIP_CLIENT_POS_MAX],
+                    _data[VSOMEIP_SESSION_POS_MIN], _data[VSOMEIP_SESSION_POS_MAX])));
+
+    if ((has_more && (0 == its_length || (its_length & 0xF)))
+            || its_offset + its_length > its_policy.max_message_size_
+            || its_offset + its_length < its_offset) {
+        VSOMEIP_ERROR << "Dropping SOME/IP-TP message of service "
+                << std::hex << std::setw(4) << std::setfill('0')
+                << its_service << " because of an invalid or oversized segment";
+        messages_.erase(its_key);
+        return its_message;
+    }
+
+    auto found_message = messages_.find(its_key);
+    if (found_message == messages_.end()) {
+        limit(_sender);
+        message &its_new = messages_[its_key];
+        its_new.buffer_ = std::make_shared<message_buffer_t>(
+                _data, _data + VSOMEIP_PAYLOAD_POS);
+        its_new.received_ = 0;
+        its_new.has_last_ = false;
+        its_new.expiration_ = its_now + its_policy.timeout_;
+        found_message = messages_.find(its_key);
+    }
+    message &its_entry = found_message->second;
+
+    // Segments must neither overlap others nor exceed the last one
+    std::uint32_t its_end = its_offset + its_length;
+    std::uint32_t its_size = std::uint32_t(its_entry.buffer_->size())
+            - VSOMEIP_PAYLOAD_POS;
+    auto found_next = its_entry.segments_.lower_bound(its_offset);
+    if (found_next != its_entry.segments_.end()
+            && found_next->first == its_offset
+            && found_next->second == its_length) {
+        return its_message; // duplicate
+    }
+    bool is_valid = (found_next == its_entry.segments_.end()
+            || found_next->first >= its_end);
+    if (is_valid && found_next != its_entry.segments_.begin()) {
+        auto found_previous = std::prev(found_next);
+        is_valid = (found_previous->first + found_previous->second
+                <= its_offset);
+    }
+    if (is_valid && its_entry.has_last_)
+        is_valid = (has_more ? its_end <= its_size : its_end == its_size);
+    if (is_valid && !has_more)
+        is_valid = (its_size <= its_end);
+    if (!is_valid) {
+        VSOMEIP_WARNING << "Dropping overlapping SOME/IP-TP segment of service "
+                << std::hex << std::setw(4) << std::setfill('0')
+                << its_service;
+        return its_message;
+    }
+
+    if (its_size < its_end)
+        its_entry.buffer_->resize(VSOMEIP_PAYLOAD_POS + its_end);
+    std::memcpy(&(*its_entry.buffer_)[VSOMEIP_PAYLOAD_POS + its_offset],
+            &_data[VSOMEIP_PAYLOAD_POS + VSOMEIP_TP_HEADER_SIZE], its_length);
+    its_entry.segments_[its_offset] = its_length;
+    its_entry.received_ += its_length;
+    if (!has_more)
+        its_entry.has_last_ = true;
+
+    if (its_entry.has_last_
+            && its_entry.received_ + VSOMEIP_PAYLOAD_POS
+                == its_entry.buffer_->size()) {
+        its_message = its_entry.buffer_;
+        messages_.erase(found_message);
+
+        byte_t *its_data = &(*its_message)[0];
+        std::uint32_t its_message_length = std::uint32_t(its_message->size())
+                - VSOMEIP_SOMEIP_HEADER_SIZE;
+        its_data[VSOMEIP_LENGTH_POS_MIN] = VSOMEIP_LONG_BYTE3(its_message_length);
+        its_data[VSOMEIP_LENGTH_POS_MIN + 1] = VSOMEIP_LONG_BYTE2(its_message_length);
+        its_data[VSOMEIP_LENGTH_POS_MIN + 2] = VSOMEIP_LONG_BYTE1(its_message_length);
+        its_data[VSOMEIP_LENGTH_POS_MAX] = VSOMEIP_LONG_BYTE0(its_message_length);
+        its_data[VSOMEIP_MESSAGE_TYPE_POS] = byte_t(
+                its_data[VSOMEIP_MESSAGE_TYPE_POS] & ~VSOMEIP_TP_FLAG);
+    }
+
+    return its_message;
+}
+
+bool tp::is_segment(const byte_t *_data, std::uint32_t _size) {
+    return (_size > VSOMEIP_MESSAGE_TYPE_POS
+            && 0 != (_data[VSOMEIP_MESSAGE_TYPE_POS] & VSOMEIP_TP_FLAG));
+}
+
+void tp::expire(std::chrono::steady_clock::time_point _now) {
+    for (auto i = messages_.begin(); i != messages_.end();) {
+        if (i->second.expiration_ <= _now) {
+            VSOMEIP_WARNING << "SOME/IP-TP reassembly timed out for message "
+                    << std::hex << std::setw(16) << std::setfill('0')
+                    << i->first.second << " from "
+                    << i->first.first.address().to_string() << ":"
+                    << std::dec << i->first.first.port();
+            i = messages_.erase(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+// Bounds the number of messages that are reassembled for a single sender.
+// If the bound is reached, the message that expires first is dropped.
+void tp::limit(const endpoint_type &_sender) {
+    auto its_begin = messages_.lower_bound(message_key_t(_sender, 0));
+    std::size_t its_count(0);
+    auto its_oldest = messages_.end();
+    for (auto i = its_begin; i != messages_.end() && i->first.first == _sender;
+            ++i) {
+        its_count++;
+        if (its_oldest == messages_.end()
+                || i->second.expiration_ < its_oldest->second.expiration_)
+            its_oldest = i;
+    }
+    if (its_count >= VSOMEIP_MAX_TP_PENDING_MESSAGES) {
+        VSOMEIP_WARNING << "Too many pending SOME/IP-TP messages from "
+                << _sender.address().to_string() << ":" << _sender.port()
+                << ", dropping the oldest";
+        messages_.erase(its_oldest);
+    }
+}
+
+} // namespace vsomeip
@@ -46,6 +46,32 @@ void udp_client_endpoint_impl::start() {
     connect();
 }
 
+bool udp_client_endpoint_impl::send(const uint8_t *_data, uint32_t _size,
+        bool _flush) {
+    std::vector<message_buffer_ptr_t> its_segments;
+    if (_size > max_message_size_
+            && tp_.segment(_data, _size, max_message_size_, its_segments)) {
+        bool is_sent(true);
+        for (auto &s : its_segments)
+            is_sent = udp_client_endpoint_base_impl::send(s, true) && is_sent;
+        return is_sent;
+    }
+    return udp_client_endpoint_base_impl::send(_data, _size, _flush);
+}
+
+bool udp_client_endpoint_impl::send(const message_buffer_ptr_t &_buffer,
+        bool _flush) {
+    if (_buffer->size() > max_message_size_)
+        return send(&(*_buffer)[0], uint32_t(_buffer->size()), _flush);
+    return udp_client_endpoint_base_impl::send(_buffer, _flush);
+}
+
+void udp_client_endpoint_impl::set_tp_policy(service_t _service,
+        std::uint32_t _max_segment_length, std::uint32_t _max_message_size,
+        std::uint32_t _timeout) {
+    tp_.set_policy(_service, _max_segment_length, _max_message_size, _timeout);
+}
+
 void udp_client_endpoint_impl::send_queued() {
     message_buffer_ptr_t its_buffer = queue_.front();
 #if 0
@@ -120,7 +146,17 @@ void udp_client_endpoint_impl::receive_cbk(
                     (uint32_t) recv_buffer_size_);
         if (current_message_size > VSOMEIP_SOMEIP_HEADER_SIZE &&
                 current_message_size <= _bytes) {
-            its_host->on_message(&recv_buffer_[0], current_message_size, this);
+            if (tp::is_segment(&recv_buffer_[0], current_message_size)) {
+                message_buffer_ptr_t its_message = tp_.reassemble(remote_,
+                        &recv_buffer_[0], current_message_size);
+                if (its_message) {
+                    its_host->on_message(&(*its_message)[0],
+                            uint32_t(its_message->size()), this);
+                }
+            } else {
+                its_host->on_message(&recv_buffer_[0], current_message_size,
+                        this);
+            }
         } else {
             VSOMEIP_ERROR << "Received a unreliable vSomeIP message with bad length field";
         }
@@ -3,6 +3,7 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 
@@ -11,6 +12,7 @@
 #include "../include/endpoint_definition.hpp"
 #include "../include/endpoint_host.hpp"
 #include "../include/udp_server_endpoint_impl.hpp"
+#include "../../configuration/include/internal.hpp"
 #include "../../logging/include/logger.hpp"
 #include "../../utility/include/byteorder.hpp"
 #include "../../utility/include/utility.hpp"
@@ -40,6 +42,22 @@ udp_server_endpoint_impl::udp_server_endpoint_impl(
 
     boost::asio::socket_base::broadcast option(true);
     socket_.set_option(option);
+
+#ifdef __linux__
+    batch_buffers_.resize(VSOMEIP_DEFAULT_UDP_RECEIVE_BATCH,
+            receive_buffer_t(VSOMEIP_MAX_UDP_MESSAGE_SIZE, 0));
+    batch_remotes_.resize(VSOMEIP_DEFAULT_UDP_RECEIVE_BATCH);
+    batch_vectors_.resize(VSOMEIP_DEFAULT_UDP_RECEIVE_BATCH);
+    batch_headers_.resize(VSOMEIP_DEFAULT_UDP_RECEIVE_BATCH);
+    for (std::size_t i = 0; i < VSOMEIP_DEFAULT_UDP_RECEIVE_BATCH; ++i) {
+        batch_vectors_[i].iov_base = &batch_buffers_[i][0];
+        batch_vectors_[i].iov_len = batch_buffers_[i].size();
+        std::memset(&batch_headers_[i], 0, sizeof(struct mmsghdr));
+        batch_headers_[i].msg_hdr.msg_name = batch_remotes_[i].data();
+        batch_headers_[i].msg_hdr.msg_iov = &batch_vectors_[i];
+        batch_headers_[i].msg_hdr.msg_iovlen = 1;
+    }
+#endif
 }
 
 udp_server_endpoint_impl::~udp_server_endpoint_impl() {
@@ -55,12 +73,44 @@ void udp_server_endpoint_impl::start() {
 
 void udp_server_endpoint_impl::stop() {
     std::lock_guard<std::mutex> its_lock(stop_mutex_);
+#ifdef USE_IO_URING
+    if (uring_)
+        uring_->stop();
+#endif
     if (socket_.is_open()) {
         socket_.close();
     }
 }
 
 void udp_server_endpoint_impl::receive() {
+#ifdef __linux__
+    std::lock_guard<std::mutex> its_lock(stop_mutex_);
+#ifdef USE_IO_URING
+    if (uring_ && socket_.is_open()) {
+        uring_->async_wait(
+            std::bind(
+                &udp_server_endpoint_impl::receive_uring_cbk,
+                std::dynamic_pointer_cast<
+                    udp_server_endpoint_impl >(shared_from_this()),
+                std::placeholders::_1
+            )
+        );
+        return;
+    }
+#endif
+    if (socket_.is_open()) {
+        // Only wait for the socket to become readable, the datagrams
+        // are fetched in batches by receive_batch_cbk.
+        socket_.async_receive(boost::asio::null_buffers(),
+            std::bind(
+                &udp_server_endpoint_impl::receive_batch_cbk,
+                std::dynamic_pointer_cast<
+                    udp_server_endpoint_impl >(shared_from_this()),
+                std::placeholders::_1
+            )
+        );
+    }
+#else
     if (recv_buffer_size_ == max_message_size_) {
         // Overrun -> Reset buffer
         recv_buffer_size_ = 0;
@@ -80,6 +130,7 @@ void udp_server_endpoint_impl::receive() {
             )
         );
     }
+#endif
 }
 
 void udp_server_endpoint_impl::restart() {
@@ -89,10 +140,123 @@ void udp_server_endpoint_impl::restart() {
 bool udp_server_endpoint_impl::send_to(
     const std::shared_ptr<endpoint_definition> _target,
     const byte_t *_data, uint32_t _size, bool _flush) {
+  std::lock_guard<std::mutex> its_lock(mutex_);
   endpoint_type its_target(_target->get_address(), _target->get_port());
   return send_intern(its_target, _data, _size, _flush);
 }
 
+bool udp_server_endpoint_impl::send_to(
+    const std::shared_ptr<endpoint_definition> _target,
+    const message_buffer_ptr_t &_buffer, bool _flush) {
+  endpoint_type its_target(_target->get_address(), _target->get_port());
+  return send_intern(its_target, _buffer, _flush);
+}
+
+bool udp_server_endpoint_impl::send_to(
+        const std::vector<std::shared_ptr<endpoint_definition> > &_targets,
+        const message_buffer_ptr_t &_buffer) {
+#ifdef __linux__
+    // Oversized messages are segmented per target
+    if (_buffer->size() > max_message_size_)
+        return udp_server_endpoint_base_impl::send_to(_targets, _buffer);
+
+    std::lock_guard<std::mutex> its_lock(mutex_);
+
+    // Targets with pending data must keep their order and are
+    // served by their queues, all others are sent at once.
+    std::vector<endpoint_type> its_targets;
+    its_targets.reserve(_targets.size());
+    for (auto t : _targets) {
+        endpoint_type its_target(t->get_address(), t->get_port());
+        auto found_packetizer = packetizer_.find(its_target);
+        auto found_queue = queues_.find(its_target);
+        if (found_packetizer != packetizer_.end()
+                && !found_packetizer->second->empty()) {
+            send_intern(its_target, &(*_buffer)[0],
+                    uint32_t(_buffer->size()), true);
+        } else if (found_queue != queues_.end()
+                && !found_queue->second.empty()) {
+            found_queue->second.push_back(_buffer);
+        } else {
+            its_targets.push_back(its_target);
+        }
+    }
+
+    if (its_targets.empty())
+        return true;
+
+    struct iovec its_vector;
+    its_vector.iov_base = &(*_buffer)[0];
+    its_vector.iov_len = _buffer->size();
+
+    std::vector<struct mmsghdr> its_headers(its_targets.size());
+    for (std::size_t i = 0; i < its_targets.size(); ++i) {
+        std::memset(&its_headers[i], 0, sizeof(struct mmsghdr));
+        its_headers[i].msg_hdr.msg_name = its_targets[i].data();
+        its_headers[i].msg_hdr.msg_namelen = socklen_t(its_targets[i].size());
+        its_headers[i].msg_hdr.msg_iov = &its_vector;
+        its_headers[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    int its_sent = sendmmsg(socket_.native_handle(), &its_headers[0],
+            (unsigned int)its_headers.size(), MSG_DONTWAIT);
+    if (its_sent < 0)
+        its_sent = 0;
+
+    // Whatever the socket did not take is queued as usual
+    for (std::size_t i = std::size_t(its_sent); i < its_targets.size(); ++i) {
+        queue_iterator_type its_queue = queues_.find(its_targets[i]);
+        if (its_queue == queues_.end()) {
+            its_queue = queues_.insert(queues_.begin(),
+                            std::make_pair(
+                                its_targets[i],
+                                std::deque<message_buffer_ptr_t>()
+                            ));
+        }
+        its_queue->second.push_back(_buffer);
+        if (its_queue->second.size() == 1) {
+            send_queued(its_queue);
+        }
+    }
+
+    return true;
+#else
+    return udp_server_endpoint_base_impl::send_to(_targets, _buffer);
+#endif
+}
+
+bool udp_server_endpoint_impl::send_intern(endpoint_type _target,
+        const byte_t *_data, uint32_t _size, bool _flush) {
+    std::vector<message_buffer_ptr_t> its_segments;
+    if (_size > max_message_size_
+            && tp_.segment(_data, _size, max_message_size_, its_segments)) {
+        bool is_sent(true);
+        for (auto &s : its_segments) {
+            is_sent = udp_server_endpoint_base_impl::send_intern(_target,
+                    &(*s)[0], uint32_t(s->size()), true) && is_sent;
+        }
+        return is_sent;
+    }
+    return udp_server_endpoint_base_impl::send_intern(_target, _data, _size,
+            _flush);
+}
+
+bool udp_server_endpoint_impl::send_intern(endpoint_type _target,
+        const message_buffer_ptr_t &_buffer, bool _flush) {
+    if (_buffer->size() > max_message_size_) {
+        std::lock_guard<std::mutex> its_lock(mutex_);
+        return send_intern(_target, &(*_buffer)[0], uint32_t(_buffer->size()),
+                _flush);
+    }
+    return udp_server_endpoint_base_impl::send_intern(_target, _buffer, _flush);
+}
+
+void udp_server_endpoint_impl::set_tp_policy(service_t _service,
+        std::uint32_t _max_segment_length, std::uint32_t _max_message_size,
+        std::uint32_t _timeout) {
+    tp_.set_policy(_service, _max_segment_length, _max_message_size, _timeout);
+}
+
 void udp_server_endpoint_impl::send_queued(
         queue_iterator_type _queue_iterator) {
     message_buffer_ptr_t its_buffer = _queue_iterator->second.front();
@@ -209,6 +373,10 @@ unsigned short udp_server_endpoint_impl::get_local_port() const {
     return socket_.local_endpoint().port();
 }
 
+unsigned short udp_server_endpoint_impl::get_remote_port() const {
+    return remote_.port();
+}
+
 // TODO: find a better way to structure the receive functions
 void udp_server_endpoint_impl::receive_cbk(
         boost::system::error_code const &_error, std::size_t _bytes) {
@@ -224,32 +392,7 @@ void udp_server_endpoint_impl::receive_cbk(
     if (its_host) {
         if (!_error && 0 < _bytes) {
             recv_buffer_size_ += _bytes;
-            uint32_t current_message_size
-                = utility::get_message_size(&this->recv_buffer_[0],
-                        (uint32_t) recv_buffer_size_);
-            if (current_message_size > VSOMEIP_SOMEIP_HEADER_SIZE &&
-                    current_message_size <= _bytes) {
-                if (utility::is_request(
-                        recv_buffer_[VSOMEIP_MESSAGE_TYPE_POS])) {
-                    client_t its_client;
-                    std::memcpy(&its_client,
-                        &recv_buffer_[VSOMEIP_CLIENT_POS_MIN],
-                        sizeof(client_t));
-                    session_t its_session;
-                    std::memcpy(&its_session,
-                        &recv_buffer_[VSOMEIP_SESSION_POS_MIN],
-                        sizeof(session_t));
-                    clients_[its_client][its_session] = remote_;
-                }
-                its_host->on_message(&recv_buffer_[0], current_message_size, this);
-            } else {
-                VSOMEIP_ERROR << "Received a unreliable vSomeIP message with bad length field";
-                service_t its_service = VSOMEIP_BYTES_TO_WORD(recv_buffer_[VSOMEIP_SERVICE_POS_MIN],
-                        recv_buffer_[VSOMEIP_SERVICE_POS_MAX]);
-                if (its_service != VSOMEIP_SD_SERVICE) {
-                    its_host->on_error(&recv_buffer_[0], (uint32_t)_bytes, this);
-                }
-            }
+            deliver(its_host, &recv_buffer_[0], recv_buffer_size_);
             recv_buffer_size_ = 0;
             restart();
         } else {
@@ -258,8 +401,136 @@ void udp_server_endpoint_impl::receive_cbk(
     }
 }
 
+#ifdef __linux__
+void udp_server_endpoint_impl::receive_batch_cbk(
+        boost::system::error_code const &_error) {
+    std::shared_ptr<endpoint_host> its_host = this->host_.lock();
+    if (!its_host)
+        return;
+
+    if (!_error) {
+        int its_count(0);
+        {
+            std::lock_guard<std::mutex> its_lock(stop_mutex_);
+            if (!socket_.is_open())
+                return;
+
+            for (auto &h : batch_headers_)
+                h.msg_hdr.msg_namelen = socklen_t(batch_remotes_[0].capacity());
+
+            its_count = recvmmsg(socket_.native_handle(), &batch_headers_[0],
+                    (unsigned int)batch_headers_.size(), MSG_DONTWAIT, 0);
+        }
+
+        for (int i = 0; i < its_count; ++i) {
+            if (0 < batch_headers_[i].msg_len) {
+                batch_remotes_[i].resize(batch_headers_[i].msg_hdr.msg_namelen);
+                remote_ = batch_remotes_[i];
+                deliver(its_host, &batch_buffers_[i][0],
+                        batch_headers_[i].msg_len);
+            }
+        }
+    }
+    receive();
+}
+#endif
+
+#ifdef USE_IO_URING
+void udp_server_endpoint_impl::receive_uring_cbk(
+        boost::system::error_code const &_error) {
+    std::shared_ptr<endpoint_host> its_host = this->host_.lock();
+    if (!its_host || _error == boost::asio::error::operation_aborted)
+        return;
+
+    if (!_error) {
+        {
+            std::lock_guard<std::mutex> its_lock(stop_mutex_);
+            if (!socket_.is_open())
+                return;
+            uring_->fetch(uring_datagrams_);
+        }
+
+        for (auto &d : uring_datagrams_) {
+            if (0 < d.size_) {
+                remote_.resize(d.namelen_);
+                std::memcpy(remote_.data(), d.name_, d.namelen_);
+                deliver(its_host, d.data_, d.size_);
+            }
+        }
+
+        std::lock_guard<std::mutex> its_lock(stop_mutex_);
+        uring_->release(uring_datagrams_);
+        uring_datagrams_.clear();
+        if (uring_->is_unsupported()) {
+            VSOMEIP_WARNING << "Receiving on port " << local_.port()
+                    << " without io_uring";
+            uring_->stop();
+            uring_.reset();
+        }
+    }
+    receive();
+}
+#endif
+
+void udp_server_endpoint_impl::enable_io_uring(std::uint32_t _buffers) {
+#ifdef USE_IO_URING
+    std::lock_guard<std::mutex> its_lock(stop_mutex_);
+    std::shared_ptr<uring_receiver> its_receiver
+        = std::make_shared<uring_receiver>(service_);
+    if (its_receiver->start(socket_.native_handle(), _buffers,
+            VSOMEIP_MAX_UDP_MESSAGE_SIZE)) {
+        uring_ = its_receiver;
+        uring_datagrams_.reserve(_buffers);
+    } else {
+        VSOMEIP_WARNING << "Receiving on port " << local_.port()
+                << " without io_uring";
+    }
+#else
+    (void)_buffers;
+    VSOMEIP_WARNING << "io_uring is enabled in the configuration, but "
+            << "vsomeip was built without io_uring support";
+#endif
+}
+
+void udp_server_endpoint_impl::deliver(
+        const std::shared_ptr<endpoint_host> &_host,
+        const byte_t *_data, std::size_t _size) {
+    uint32_t current_message_size
+        = utility::get_message_size(_data, (uint32_t) _size);
+    if (current_message_size > VSOMEIP_SOMEIP_HEADER_SIZE &&
+            current_message_size <= _size) {
+        message_buffer_ptr_t its_message;
+        if (tp::is_segment(_data, current_message_size)) {
+            its_message = tp_.reassemble(remote_, _data, current_message_size);
+            if (!its_message)
+                return;
+            _data = &(*its_message)[0];
+            current_message_size = uint32_t(its_message->size());
+        }
+        if (utility::is_request(_data[VSOMEIP_MESSAGE_TYPE_POS])) {
+            client_t its_client;
+            std::memcpy(&its_client, &_data[VSOMEIP_CLIENT_POS_MIN],
+                sizeof(client_t));
+            session_t its_session;
+            std::memcpy(&its_session, &_data[VSOMEIP_SESSION_POS_MIN],
+                sizeof(session_t));
+            std::lock_guard<std::mutex> its_lock(mutex_);
+            clients_[its_client][its_session] = remote_;
+        }
+        _host->on_message(_data, current_message_size, this);
+    } else {
+        VSOMEIP_ERROR << "Received a unreliable vSomeIP message with bad length field";
+        service_t its_service = VSOMEIP_BYTES_TO_WORD(
+                _data[VSOMEIP_SERVICE_POS_MIN], _data[VSOMEIP_SERVICE_POS_MAX]);
+        if (its_service != VSOMEIP_SD_SERVICE) {
+            _host->on_error(_data, (uint32_t)_size, this);
+        }
+    }
+}
+
 client_t udp_server_endpoint_impl::get_client(std::shared_ptr<endpoint_definition> _endpoint) {
     endpoint_type endpoint(_endpoint->get_address(), _endpoint->get_port());
+    std::lock_guard<std::mutex> its_lock(mutex_);
     for (auto its_client : clients_) {
         for (auto its_session : clients_[its_client.first]) {
             if (endpoint == its_session.second) {
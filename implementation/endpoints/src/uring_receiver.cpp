@@ -0,0 +1,349 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifdef USE_IO_URING
+
+#include <cerrno>
+#include <cstring>
+
+#include <netinet/in.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "../include/uring_receiver.hpp"
+#include "../../logging/include/logger.hpp"
+
+#define VSOMEIP_URING_RECEIVE   1
+#define VSOMEIP_URING_CANCEL    2
+
+#define VSOMEIP_URING_PROBE_OPS 256
+
+namespace vsomeip {
+
+uring_receiver::uring_receiver(boost::asio::io_service &_io)
+    : descriptor_(_io),
+      fd_(-1),
+      socket_(-1),
+      is_armed_(false),
+      is_unsupported_(false),
+      sq_ring_(MAP_FAILED),
+      sq_ring_size_(0),
+      cq_ring_(MAP_FAILED),
+      cq_ring_size_(0),
+      sqes_(0),
+      sqes_size_(0),
+      buf_ring_(0),
+      buf_ring_size_(0),
+      buf_entries_(0),
+      buf_tail_(0),
+      buffer_size_(0) {
+    std::memset(&header_, 0, sizeof(header_));
+}
+
+uring_receiver::~uring_receiver() {
+    stop();
+    cleanup();
+}
+
+bool uring_receiver::start(int _socket, std::uint32_t _buffers,
+        std::size_t _max_size) {
+    socket_ = _socket;
+    // Multishot receives prefix the datagram with the header and the sender
+    header_.msg_namelen = sizeof(struct sockaddr_in6);
+    buffer_size_ = sizeof(struct io_uring_recvmsg_out) + header_.msg_namelen
+            + _max_size;
+
+    if (!setup(_buffers) || !arm()) {
+        cleanup();
+        return false;
+    }
+
+    boost::system::error_code its_error;
+    descriptor_.assign(fd_, its_error);
+    if (its_error) {
+        cleanup();
+        return false;
+    }
+    return true;
+}
+
+void uring_receiver::stop() {
+    if (fd_ < 0)
+        return;
+
+    if (is_armed_) {
+        unsigned its_tail = *sq_tail_;
+        unsigned its_index = its_tail & *sq_mask_;
+        struct io_uring_sqe &its_sqe = sqes_[its_index];
+        std::memset(&its_sqe, 0, sizeof(its_sqe));
+        its_sqe.opcode = IORING_OP_ASYNC_CANCEL;
+        its_sqe.fd = -1;
+        its_sqe.addr = VSOMEIP_URING_RECEIVE;
+        its_sqe.user_data = VSOMEIP_URING_CANCEL;
+        sq_array_[its_index] = its_index;
+        __atomic_store_n(sq_tail_, its_tail + 1, __ATOMIC_RELEASE);
+
+        // Wait until the kernel does no longer write into the buffers
+        unsigned its_flags = IORING_ENTER_GETEVENTS;
+        bool is_submitted(false);
+        while (is_armed_) {
+            if (syscall(__NR_io_uring_enter, fd_, is_submitted ? 0 : 1, 1,
+                    its_flags, 0, 0) < 0 && errno != EINTR)
+                break;
+            is_submitted = true;
+
+            unsigned its_head = *cq_head_;
+            unsigned its_cq_tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+            for (; its_head != its_cq_tail; ++its_head) {
+                struct io_uring_cqe &its_cqe = cqes_[its_head & *cq_mask_];
+                if (its_cqe.user_data == VSOMEIP_URING_RECEIVE
+                        && !(its_cqe.flags & IORING_CQE_F_MORE))
+                    is_armed_ = false;
+            }
+            __atomic_store_n(cq_head_, its_head, __ATOMIC_RELEASE);
+        }
+    }
+
+    boost::system::error_code its_error;
+    descriptor_.close(its_error);
+    fd_ = -1;
+}
+
+void uring_receiver::fetch(std::vector<datagram> &_datagrams) {
+    if (fd_ < 0)
+        return;
+
+    unsigned its_head = *cq_head_;
+    unsigned its_tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    for (; its_head != its_tail; ++its_head) {
+        struct io_uring_cqe &its_cqe = cqes_[its_head & *cq_mask_];
+        if (its_cqe.user_data != VSOMEIP_URING_RECEIVE)
+            continue;
+
+        if (!(its_cqe.flags & IORING_CQE_F_MORE))
+            is_armed_ = false;
+
+        if (its_cqe.res < 0) {
+            // Kernels that know receive messages, but not the multishot
+            // variant, reject it as invalid argument
+            if (its_cqe.res == -EINVAL && !is_armed_) {
+                VSOMEIP_WARNING << "io_uring multishot receive is not supported";
+                is_unsupported_ = true;
+            } else if (its_cqe.res != -ENOBUFS)
+                VSOMEIP_ERROR << "io_uring receive failed: "
+                        << std::strerror(-its_cqe.res);
+            continue;
+        }
+
+        if (its_cqe.flags & IORING_CQE_F_BUFFER) {
+            std::uint16_t its_buffer = std::uint16_t(
+                    its_cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+            byte_t *its_data = &buffers_[its_buffer * buffer_size_];
+            struct io_uring_recvmsg_out *its_out
+                = reinterpret_cast<struct io_uring_recvmsg_out *>(its_data);
+            datagram its_datagram;
+            its_datagram.name_ = reinterpret_cast<const struct sockaddr *>(
+                    its_data + sizeof(struct io_uring_recvmsg_out));
+            its_datagram.namelen_ = socklen_t(its_out->namelen);
+            if (its_datagram.namelen_ > header_.msg_namelen)
+                its_datagram.namelen_ = header_.msg_namelen;
+            its_datagram.data_ = its_data
+                    + sizeof(struct io_uring_recvmsg_out)
+                    + header_.msg_namelen + header_.msg_controllen;
+            its_datagram.size_ = its_out->payloadlen;
+            its_datagram.buffer_ = its_buffer;
+            if (its_out->flags & MSG_TRUNC)
+                its_datagram.size_ = 0;
+            _datagrams.push_back(its_datagram);
+        }
+    }
+    __atomic_store_n(cq_head_, its_head, __ATOMIC_RELEASE);
+}
+
+void uring_receiver::release(const std::vector<datagram> &_datagrams) {
+    if (fd_ < 0)
+        return;
+
+    for (auto &d : _datagrams)
+        provide(d.buffer_);
+    __atomic_store_n(&buf_ring_->tail, buf_tail_, __ATOMIC_RELEASE);
+
+    if (!is_armed_ && !is_unsupported_)
+        arm();
+}
+
+bool uring_receiver::setup(std::uint32_t _buffers) {
+    // Buffer rings must have a power of two entries
+    buf_entries_ = 1;
+    while (buf_entries_ < _buffers && buf_entries_ < 0x8000)
+        buf_entries_ <<= 1;
+
+    struct io_uring_params its_params;
+    std::memset(&its_params, 0, sizeof(its_params));
+    its_params.flags = IORING_SETUP_CQSIZE;
+    its_params.cq_entries = buf_entries_ * 2;
+
+    fd_ = int(syscall(__NR_io_uring_setup, 4, &its_params));
+    if (fd_ < 0) {
+        VSOMEIP_WARNING << "io_uring is not available: "
+                << std::strerror(errno);
+        return false;
+    }
+
+    // Check for receive messages before anything is mapped
+    std::vector<byte_t> its_probe_data(sizeof(struct io_uring_probe)
+            + VSOMEIP_URING_PROBE_OPS * sizeof(struct io_uring_probe_op));
+    struct io_uring_probe *its_probe = reinterpret_cast<
+            struct io_uring_probe *>(&its_probe_data[0]);
+    if (syscall(__NR_io_uring_register, fd_, IORING_REGISTER_PROBE,
+            its_probe, VSOMEIP_URING_PROBE_OPS) < 0) {
+        VSOMEIP_WARNING << "io_uring operations cannot be probed: "
+                << std::strerror(errno);
+        return false;
+    }
+    // As for the buffer ring, the flexible array member is not used
+    struct io_uring_probe_op *its_ops
+        = reinterpret_cast<struct io_uring_probe_op *>(its_probe + 1);
+    if (its_probe->last_op < IORING_OP_RECVMSG
+            || !(its_ops[IORING_OP_RECVMSG].flags & IO_URING_OP_SUPPORTED)) {
+        VSOMEIP_WARNING << "io_uring receive is not supported";
+        return false;
+    }
+
+    sq_ring_size_ = its_params.sq_off.array
+            + its_params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = its_params.cq_off.cqes
+            + its_params.cq_entries * sizeof(struct io_uring_cqe);
+    if (its_params.features & IORING_FEAT_SINGLE_MMAP) {
+        if (cq_ring_size_ > sq_ring_size_)
+            sq_ring_size_ = cq_ring_size_;
+        cq_ring_size_ = 0;
+    }
+
+    sq_ring_ = mmap(0, sq_ring_size_, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+    if (sq_ring_ == MAP_FAILED)
+        return false;
+    if (cq_ring_size_) {
+        cq_ring_ = mmap(0, cq_ring_size_, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+        if (cq_ring_ == MAP_FAILED)
+            return false;
+    }
+    sqes_size_ = its_params.sq_entries * sizeof(struct io_uring_sqe);
+    void *its_sqes = mmap(0, sqes_size_, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+    if (its_sqes == MAP_FAILED)
+        return false;
+    sqes_ = static_cast<struct io_uring_sqe *>(its_sqes);
+
+    byte_t *its_sq = static_cast<byte_t *>(sq_ring_);
+    byte_t *its_cq = static_cast<byte_t *>(
+            cq_ring_size_ ? cq_ring_ : sq_ring_);
+    sq_tail_ = reinterpret_cast<unsigned *>(its_sq + its_params.sq_off.tail);
+    sq_mask_ = reinterpret_cast<unsigned *>(its_sq + its_params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned *>(its_sq + its_params.sq_off.array);
+    cq_head_ = reinterpret_cast<unsigned *>(its_cq + its_params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(its_cq + its_params.cq_off.tail);
+    cq_mask_ = reinterpret_cast<unsigned *>(its_cq + its_params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<struct io_uring_cqe *>(
+            its_cq + its_params.cq_off.cqes);
+
+    // Register the receive buffers
+    buf_ring_size_ = buf_entries_ * sizeof(struct io_uring_buf);
+    void *its_buf_ring = mmap(0, buf_ring_size_, PROT_READ | PROT_WRITE,
+            MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (its_buf_ring == MAP_FAILED) {
+        buf_ring_size_ = 0;
+        return false;
+    }
+    buf_ring_ = static_cast<struct io_uring_buf_ring *>(its_buf_ring);
+
+    struct io_uring_buf_reg its_reg;
+    std::memset(&its_reg, 0, sizeof(its_reg));
+    its_reg.ring_addr = reinterpret_cast<std::uint64_t>(buf_ring_);
+    its_reg.ring_entries = buf_entries_;
+    its_reg.bgid = 0;
+    if (syscall(__NR_io_uring_register, fd_, IORING_REGISTER_PBUF_RING,
+            &its_reg, 1) < 0) {
+        VSOMEIP_WARNING << "io_uring buffer rings are not supported: "
+                << std::strerror(errno);
+        return false;
+    }
+
+    buffers_.resize(buf_entries_ * buffer_size_);
+    buf_tail_ = 0;
+    for (std::uint32_t i = 0; i < buf_entries_; ++i)
+        provide(std::uint16_t(i));
+    __atomic_store_n(&buf_ring_->tail, buf_tail_, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+bool uring_receiver::arm() {
+    unsigned its_tail = *sq_tail_;
+    unsigned its_index = its_tail & *sq_mask_;
+    struct io_uring_sqe &its_sqe = sqes_[its_index];
+    std::memset(&its_sqe, 0, sizeof(its_sqe));
+    its_sqe.opcode = IORING_OP_RECVMSG;
+    its_sqe.fd = socket_;
+    its_sqe.addr = reinterpret_cast<std::uint64_t>(&header_);
+    its_sqe.len = 1;
+    its_sqe.flags = IOSQE_BUFFER_SELECT;
+    its_sqe.ioprio = IORING_RECV_MULTISHOT;
+    its_sqe.buf_group = 0;
+    its_sqe.user_data = VSOMEIP_URING_RECEIVE;
+    sq_array_[its_index] = its_index;
+    __atomic_store_n(sq_tail_, its_tail + 1, __ATOMIC_RELEASE);
+
+    if (syscall(__NR_io_uring_enter, fd_, 1, 0, 0, 0, 0) < 0) {
+        VSOMEIP_ERROR << "io_uring receive could not be submitted: "
+                << std::strerror(errno);
+        return false;
+    }
+    is_armed_ = true;
+    return true;
+}
+
+void uring_receiver::provide(std::uint16_t _buffer) {
+    // The ring is accessed as array as the flexible array member of the
+    // kernel header is placed differently by C++ compilers
+    struct io_uring_buf &its_buf = reinterpret_cast<struct io_uring_buf *>(
+            buf_ring_)[buf_tail_ & (buf_entries_ - 1)];
+    its_buf.addr = reinterpret_cast<std::uint64_t>(
+            &buffers_[_buffer * buffer_size_]);
+    its_buf.len = std::uint32_t(buffer_size_);
+    its_buf.bid = _buffer;
+    buf_tail_++;
+}
+
+void uring_receiver::cleanup() {
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+    if (sqes_) {
+        munmap(sqes_, sqes_size_);
+        sqes_ = 0;
+    }
+    if (cq_ring_ != MAP_FAILED) {
+        munmap(cq_ring_, cq_ring_size_);
+        cq_ring_ = MAP_FAILED;
+    }
+    if (sq_ring_ != MAP_FAILED) {
+        munmap(sq_ring_, sq_ring_size_);
+        sq_ring_ = MAP_FAILED;
+    }
+    if (buf_ring_) {
+        munmap(buf_ring_, buf_ring_size_);
+        buf_ring_ = 0;
+    }
+    is_armed_ = false;
+}
+
+} // namespace vsomeip
+
+#endif // USE_IO_URING
@@ -46,6 +46,30 @@ bool virtual_server_endpoint_impl::send_to(
     return false;
 }
 
+bool virtual_server_endpoint_impl::send(const message_buffer_ptr_t &_buffer,
+        bool _flush) {
+    (void)_buffer;
+    (void)_flush;
+    return false;
+}
+
+bool virtual_server_endpoint_impl::send_to(
+        const std::shared_ptr<endpoint_definition> _target,
+        const message_buffer_ptr_t &_buffer, bool _flush) {
+    (void)_target;
+    (void)_buffer;
+    (void)_flush;
+    return false;
+}
+
+bool virtual_server_endpoint_impl::send_to(
+        const std::vector<std::shared_ptr<endpoint_definition> > &_targets,
+        const message_buffer_ptr_t &_buffer) {
+    (void)_targets;
+    (void)_buffer;
+    return false;
+}
+
 void virtual_server_endpoint_impl::enable_magic_cookies() {
 }
 
@@ -75,6 +99,22 @@ void virtual_server_endpoint_impl::remove_multicast(
     (void)_event;
 }
 
+void virtual_server_endpoint_impl::set_flush_policy(
+        service_t _service, std::uint32_t _max_delay, std::uint32_t _max_bytes) {
+    (void)_service;
+    (void)_max_delay;
+    (void)_max_bytes;
+}
+
+void virtual_server_endpoint_impl::set_tp_policy(service_t _service,
+        std::uint32_t _max_segment_length, std::uint32_t _max_message_size,
+        std::uint32_t _timeout) {
+    (void)_service;
+    (void)_max_segment_length;
+    (void)_max_message_size;
+    (void)_timeout;
+}
+
 bool virtual_server_endpoint_impl::get_remote_address(
         boost::asio::ip::address &_address) const {
     (void)_address;
@@ -6,11 +6,14 @@
 #ifndef VSOMEIP_DESERIALIZER_HPP
 #define VSOMEIP_DESERIALIZER_HPP
 
+#include <memory>
 #include <vector>
 
 #include <vsomeip/export.hpp>
 #include <vsomeip/primitive_types.hpp>
 
+#include "message_pool.hpp"
+
 namespace vsomeip {
 
 class message;
@@ -31,7 +34,7 @@ public:
     VSOMEIP_EXPORT void set_remaining(std::size_t _length);
 
     // to be used by applications to deserialize a message
-    VSOMEIP_EXPORT message * deserialize_message();
+    VSOMEIP_EXPORT std::shared_ptr<message> deserialize_message();
 
     // to be used (internally) by objects to deserialize their members
     // Note: this needs to be encapsulated!
@@ -42,6 +45,12 @@ public:
     VSOMEIP_EXPORT bool deserialize(uint8_t *_data, std::size_t _length);
     VSOMEIP_EXPORT bool deserialize(std::vector<uint8_t>& _value);
 
+    // Returns the next _length bytes without copying them. The returned
+    // buffer keeps them alive; it is never modified by the deserializer.
+    VSOMEIP_EXPORT bool deserialize(std::size_t _length,
+            std::shared_ptr<pooled_buffer_t> &_buffer,
+            const byte_t *&_data);
+
     VSOMEIP_EXPORT bool look_ahead(std::size_t _index, uint8_t &_value) const;
     VSOMEIP_EXPORT bool look_ahead(std::size_t _index, uint16_t &_value) const;
     VSOMEIP_EXPORT bool look_ahead(std::size_t _index, uint32_t &_value) const;
@@ -52,8 +61,11 @@ public:
     VSOMEIP_EXPORT void show() const;
 #endif
 protected:
-    std::vector<byte_t> data_;
-    std::vector<byte_t>::iterator position_;
+    void own_data();
+
+    // Shared with the payloads that reference it, copied on write
+    std::shared_ptr<pooled_buffer_t> data_;
+    pooled_buffer_t::iterator position_;
     std::size_t remaining_;
 };
 
@@ -0,0 +1,93 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef VSOMEIP_MESSAGE_POOL_HPP
+#define VSOMEIP_MESSAGE_POOL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <vsomeip/primitive_types.hpp>
+
+namespace vsomeip {
+
+// Recycles the memory of messages, payloads and their data. Blocks are
+// grouped into power of two size classes, each of which keeps a free list
+// of released blocks. As long as the pool is not enabled, all blocks are
+// taken from and returned to the heap.
+class message_pool {
+public:
+    static message_pool & get();
+
+    void enable(std::size_t _max_blocks);
+    bool is_enabled() const;
+
+    void * allocate(std::size_t _size);
+    void deallocate(void *_block);
+
+    std::size_t get_hits() const;
+    std::size_t get_misses() const;
+
+private:
+    message_pool();
+    ~message_pool();
+
+    static std::size_t get_class(std::size_t _size);
+
+    static const std::size_t no_class_ = std::size_t(-1);
+
+    struct size_class {
+        std::vector<void *> blocks_;
+        std::mutex mutex_;
+    };
+
+    std::vector<size_class> classes_;
+    std::atomic<bool> is_enabled_;
+    std::atomic<std::size_t> max_blocks_;
+
+    std::atomic<std::size_t> hits_;
+    std::atomic<std::size_t> misses_;
+};
+
+template<typename T>
+class message_pool_allocator {
+public:
+    typedef T value_type;
+
+    message_pool_allocator() {
+    }
+
+    template<typename U>
+    message_pool_allocator(const message_pool_allocator<U> &) {
+    }
+
+    T * allocate(std::size_t _num) {
+        return static_cast<T *>(message_pool::get().allocate(_num * sizeof(T)));
+    }
+
+    void deallocate(T *_block, std::size_t) {
+        message_pool::get().deallocate(_block);
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const message_pool_allocator<T> &,
+        const message_pool_allocator<U> &) {
+    return true;
+}
+
+template<typename T, typename U>
+bool operator!=(const message_pool_allocator<T> &,
+        const message_pool_allocator<U> &) {
+    return false;
+}
+
+typedef std::vector<byte_t, message_pool_allocator<byte_t> > pooled_buffer_t;
+
+} // namespace vsomeip
+
+#endif // VSOMEIP_MESSAGE_POOL_HPP
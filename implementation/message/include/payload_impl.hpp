@@ -6,9 +6,14 @@
 #ifndef VSOMEIP_PAYLOAD_IMPL_HPP
 #define VSOMEIP_PAYLOAD_IMPL_HPP
 
+#include <memory>
+#include <vector>
+
 #include <vsomeip/export.hpp>
 #include <vsomeip/payload.hpp>
 
+#include "message_pool.hpp"
+
 namespace vsomeip {
 
 class serializer;
@@ -33,11 +38,22 @@ public:
     VSOMEIP_EXPORT void set_data(const byte_t *_data, length_t _length);
     VSOMEIP_EXPORT void set_data(const std::vector< byte_t > &_data);
 
+    VSOMEIP_EXPORT void detach();
+
     VSOMEIP_EXPORT bool serialize(serializer *_to) const;
     VSOMEIP_EXPORT bool deserialize(deserializer *_from);
 
+    // References the next _length bytes of the deserializer instead of
+    // copying them
+    VSOMEIP_EXPORT bool deserialize(deserializer *_from, length_t _length);
+
 private:
-    std::vector<byte_t> data_;
+    pooled_buffer_t data_;
+
+    // View on the receive buffer
+    std::shared_ptr<pooled_buffer_t> buffer_;
+    const byte_t *view_data_;
+    length_t view_length_;
 };
 
 } // namespace vsomeip
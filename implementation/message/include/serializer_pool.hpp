@@ -0,0 +1,48 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef VSOMEIP_SERIALIZER_POOL_HPP
+#define VSOMEIP_SERIALIZER_POOL_HPP
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <vsomeip/primitive_types.hpp>
+
+namespace vsomeip {
+
+class deserializer;
+class serializer;
+
+// Hands out serializers and deserializers to concurrent senders/receivers.
+// The lock is only held while taking an object from or returning it to the
+// pool, not while the object is in use.
+class serializer_pool {
+public:
+    serializer_pool();
+    ~serializer_pool();
+
+    void set_capacity(uint32_t _capacity);
+
+    std::shared_ptr<serializer> get_serializer();
+    void put_serializer(const std::shared_ptr<serializer> &_serializer);
+
+    std::shared_ptr<deserializer> get_deserializer();
+    void put_deserializer(const std::shared_ptr<deserializer> &_deserializer);
+
+private:
+    uint32_t capacity_;
+
+    std::vector<std::shared_ptr<serializer> > serializers_;
+    std::mutex serializers_mutex_;
+
+    std::vector<std::shared_ptr<deserializer> > deserializers_;
+    std::mutex deserializers_mutex_;
+};
+
+} // namespace vsomeip
+
+#endif // VSOMEIP_SERIALIZER_POOL_HPP
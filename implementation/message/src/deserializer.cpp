@@ -18,27 +18,41 @@
 
 namespace vsomeip {
 
+static std::shared_ptr<pooled_buffer_t> create_buffer() {
+    return std::allocate_shared<pooled_buffer_t>(
+            message_pool_allocator<pooled_buffer_t>());
+}
+
+template<typename InputIterator>
+static std::shared_ptr<pooled_buffer_t> create_buffer(InputIterator _begin,
+        InputIterator _end) {
+    return std::allocate_shared<pooled_buffer_t>(
+            message_pool_allocator<pooled_buffer_t>(), _begin, _end);
+}
+
 deserializer::deserializer()
-    : position_(data_.begin()),
+    : data_(create_buffer()),
+      position_(data_->begin()),
       remaining_(0) {
 }
 
 deserializer::deserializer(byte_t *_data, std::size_t _length)
-    : data_(_data, _data + _length),
-      position_(data_.begin()),
+    : data_(create_buffer(_data, _data + _length)),
+      position_(data_->begin()),
       remaining_(_length) {
 }
 
 deserializer::deserializer(const deserializer &_other)
-    : data_(_other.data_),
-      position_(_other.position_){
+    : data_(create_buffer(_other.data_->begin(), _other.data_->end())),
+      position_(data_->begin() + (_other.position_ - _other.data_->begin())),
+      remaining_(_other.remaining_) {
 }
 
 deserializer::~deserializer() {
 }
 
 std::size_t deserializer::get_available() const {
-    return data_.size();
+    return data_->size();
 }
 
 std::size_t deserializer::get_remaining() const {
@@ -97,7 +111,7 @@ bool deserializer::deserialize(uint8_t *_data, std::size_t _length) {
     if (_length > remaining_)
         return false;
 
-    std::memcpy(_data, &data_[position_ - data_.begin()], _length);
+    std::memcpy(_data, &(*position_), _length);
     position_ += _length;
     remaining_ -= _length;
 
@@ -115,8 +129,21 @@ bool deserializer::deserialize(std::vector< uint8_t >& _value) {
     return true;
 }
 
+bool deserializer::deserialize(std::size_t _length,
+        std::shared_ptr<pooled_buffer_t> &_buffer, const byte_t *&_data) {
+    if (_length > remaining_)
+        return false;
+
+    _buffer = data_;
+    _data = (_length > 0 ? &(*position_) : 0);
+    position_ += _length;
+    remaining_ -= _length;
+
+    return true;
+}
+
 bool deserializer::look_ahead(std::size_t _index, uint8_t &_value) const {
-    if (_index >= data_.size())
+    if (_index >= data_->size())
         return false;
 
     _value = *(position_ + _index);
@@ -125,67 +152,82 @@ bool deserializer::look_ahead(std::size_t _index, uint8_t &_value) const {
 }
 
 bool deserializer::look_ahead(std::size_t _index, uint16_t &_value) const {
-    if (_index+1 >= data_.size())
+    if (_index+1 >= data_->size())
         return false;
 
-    std::vector< uint8_t >::iterator i = position_ + _index;
+    pooled_buffer_t::const_iterator i = position_ + _index;
     _value = VSOMEIP_BYTES_TO_WORD(*i, *(i+1));
 
     return true;
 }
 
 bool deserializer::look_ahead(std::size_t _index, uint32_t &_value) const {
-    if (_index+3 >= data_.size())
+    if (_index+3 >= data_->size())
         return false;
 
-    std::vector< uint8_t >::const_iterator i = position_ + _index;
+    pooled_buffer_t::const_iterator i = position_ + _index;
     _value = VSOMEIP_BYTES_TO_LONG(*i, *(i+1), *(i+2), *(i+3));
 
     return true;
 }
 
-message * deserializer::deserialize_message() {
-    message_impl* deserialized_message = new message_impl;
-    if (0 != deserialized_message) {
-        if (false == deserialized_message->deserialize(this)) {
-            delete deserialized_message;
-            deserialized_message = 0;
-        }
+std::shared_ptr<message> deserializer::deserialize_message() {
+    std::shared_ptr<message_impl> its_message
+        = std::allocate_shared<message_impl>(
+                message_pool_allocator<message_impl>());
+    if (false == its_message->deserialize(this)) {
+        its_message.reset();
     }
 
-    return deserialized_message;
+    return its_message;
 }
 
 void deserializer::set_data(const byte_t *_data,  std::size_t _length) {
+    if (data_.use_count() > 1)
+        data_ = create_buffer();
+
     if (0 != _data) {
-        data_.assign(_data, _data + _length);
-        position_ = data_.begin();
-        remaining_ = data_.end() - position_;
+        data_->assign(_data, _data + _length);
+        position_ = data_->begin();
+        remaining_ = data_->end() - position_;
     } else {
-        data_.clear();
-        position_ = data_.end();
+        data_->clear();
+        position_ = data_->end();
         remaining_ = 0;
     }
 }
 
 void deserializer::append_data(const byte_t *_data, std::size_t _length) {
-    std::size_t offset = (position_ - data_.begin());
-    data_.insert(data_.end(), _data, _data + _length);
-    position_ = data_.begin() + offset;
+    own_data();
+    std::size_t offset = (position_ - data_->begin());
+    data_->insert(data_->end(), _data, _data + _length);
+    position_ = data_->begin() + offset;
     remaining_ += _length;
 }
 
 void deserializer::drop_data(std::size_t _length) {
-    if (position_ + _length < data_.end())
+    if (position_ + _length < data_->end())
         position_ += _length;
     else
-        position_ = data_.end();
+        position_ = data_->end();
 }
 
 void deserializer::reset() {
-    data_.erase(data_.begin(), position_);
-    position_ = data_.begin();
-    remaining_ = data_.size();
+    if (data_.use_count() == 1) {
+        data_->erase(data_->begin(), position_);
+    } else {
+        data_ = create_buffer(position_, data_->end());
+    }
+    position_ = data_->begin();
+    remaining_ = data_->size();
+}
+
+void deserializer::own_data() {
+    if (data_.use_count() > 1) {
+        std::size_t offset = (position_ - data_->begin());
+        data_ = create_buffer(data_->begin(), data_->end());
+        position_ = data_->begin() + offset;
+    }
 }
 
 #ifdef VSOMEIP_DEBUGGING
@@ -195,9 +237,9 @@ void deserializer::show() const {
             << std::hex << std::setw(2) << std::setfill('0')
             << (int)*position_ << ", "
             << std:: dec << remaining_ << ") ";
-    for (int i = 0; i < data_.size(); ++i)
+    for (int i = 0; i < data_->size(); ++i)
         its_message << std::hex << std::setw(2) << std::setfill('0')
-                    << (int)data_[i] << " ";
+                    << (int)(*data_)[i] << " ";
     VSOMEIP_DEBUG << its_message;
 }
 #endif
@@ -8,6 +8,8 @@
 #include <vsomeip/runtime.hpp>
 
 #include "../include/message_impl.hpp"
+#include "../include/message_pool.hpp"
+#include "../include/payload_impl.hpp"
 #include "../../utility/include/byteorder.hpp"
 
 namespace vsomeip {
@@ -38,12 +40,14 @@ bool message_impl::serialize(serializer *_to) const {
 }
 
 bool message_impl::deserialize(deserializer *_from) {
-    payload_ = runtime::get()->create_payload();
+    std::shared_ptr<payload_impl> its_payload
+        = std::allocate_shared<payload_impl>(
+                message_pool_allocator<payload_impl>());
     bool is_successful = header_.deserialize(_from);
     if (is_successful) {
-        payload_->set_capacity(header_.length_);
-        is_successful = payload_->deserialize(_from);
+        is_successful = its_payload->deserialize(_from, header_.length_);
     }
+    payload_ = its_payload;
     return is_successful;
 }
 
@@ -0,0 +1,110 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <new>
+
+#include "../include/message_pool.hpp"
+#include "../../configuration/include/internal.hpp"
+
+namespace vsomeip {
+
+message_pool & message_pool::get() {
+    // Never destroyed as blocks may be released during static destruction
+    static message_pool *the_pool = new message_pool;
+    return (*the_pool);
+}
+
+message_pool::message_pool()
+    : classes_(VSOMEIP_MESSAGE_POOL_MAX_CLASS - VSOMEIP_MESSAGE_POOL_MIN_CLASS + 1),
+      is_enabled_(false), max_blocks_(0), hits_(0), misses_(0) {
+}
+
+message_pool::~message_pool() {
+}
+
+void message_pool::enable(std::size_t _max_blocks) {
+    if (is_enabled_)
+        return;
+
+    for (auto &its_class : classes_) {
+        std::lock_guard<std::mutex> its_lock(its_class.mutex_);
+        its_class.blocks_.reserve(_max_blocks);
+    }
+    // Deallocation may run on any thread, also on ones that did not
+    // observe is_enabled_ yet
+    max_blocks_ = _max_blocks;
+    is_enabled_ = true;
+}
+
+bool message_pool::is_enabled() const {
+    return is_enabled_;
+}
+
+void * message_pool::allocate(std::size_t _size) {
+    std::size_t its_class = no_class_;
+    std::size_t its_size = _size;
+    void *its_block(0);
+
+    if (is_enabled_) {
+        its_class = get_class(_size);
+        if (its_class != no_class_) {
+            its_size = (std::size_t(1) << (its_class + VSOMEIP_MESSAGE_POOL_MIN_CLASS));
+
+            size_class &its_free = classes_[its_class];
+            std::lock_guard<std::mutex> its_lock(its_free.mutex_);
+            if (!its_free.blocks_.empty()) {
+                its_block = its_free.blocks_.back();
+                its_free.blocks_.pop_back();
+            }
+        }
+
+        if (its_block) {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return (static_cast<char *>(its_block) + VSOMEIP_MESSAGE_POOL_HEADER_SIZE);
+        }
+        misses_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    its_block = ::operator new(its_size + VSOMEIP_MESSAGE_POOL_HEADER_SIZE);
+    *static_cast<std::size_t *>(its_block) = its_class;
+    return (static_cast<char *>(its_block) + VSOMEIP_MESSAGE_POOL_HEADER_SIZE);
+}
+
+void message_pool::deallocate(void *_block) {
+    void *its_block = static_cast<char *>(_block) - VSOMEIP_MESSAGE_POOL_HEADER_SIZE;
+    std::size_t its_class = *static_cast<std::size_t *>(its_block);
+
+    if (its_class != no_class_) {
+        size_class &its_free = classes_[its_class];
+        std::lock_guard<std::mutex> its_lock(its_free.mutex_);
+        if (its_free.blocks_.size() < max_blocks_) {
+            its_free.blocks_.push_back(its_block);
+            return;
+        }
+    }
+
+    ::operator delete(its_block);
+}
+
+std::size_t message_pool::get_hits() const {
+    return hits_;
+}
+
+std::size_t message_pool::get_misses() const {
+    return misses_;
+}
+
+std::size_t message_pool::get_class(std::size_t _size) {
+    std::size_t its_class(0);
+    while ((std::size_t(1) << (its_class + VSOMEIP_MESSAGE_POOL_MIN_CLASS))
+            < _size) {
+        if (++its_class + VSOMEIP_MESSAGE_POOL_MIN_CLASS
+                > VSOMEIP_MESSAGE_POOL_MAX_CLASS)
+            return no_class_;
+    }
+    return its_class;
+}
+
+} // namespace vsomeip
@@ -3,6 +3,8 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <cstring>
+
 #include "../include/deserializer.hpp"
 #include "../include/payload_impl.hpp"
 #include "../include/serializer.hpp"
@@ -10,19 +12,21 @@
 namespace vsomeip {
 
 payload_impl::payload_impl()
-    : data_() {
+    : data_(), view_data_(0), view_length_(0) {
 }
 
-payload_impl::payload_impl(const byte_t *_data, uint32_t _size) {
+payload_impl::payload_impl(const byte_t *_data, uint32_t _size)
+    : view_data_(0), view_length_(0) {
     data_.assign(_data, _data + _size);
 }
 
 payload_impl::payload_impl(const std::vector<byte_t> &_data)
-    : data_(_data) {
+    : data_(_data.begin(), _data.end()), view_data_(0), view_length_(0) {
 }
 
 payload_impl::payload_impl(const payload_impl& _payload)
-    : data_(_payload.data_) {
+    : data_(_payload.get_data(), _payload.get_data() + _payload.get_length()),
+      view_data_(0), view_length_(0) {
 }
 
 payload_impl::~payload_impl() {
@@ -32,7 +36,8 @@ bool payload_impl::operator==(const payload &_other) {
     bool is_equal(true);
     try {
         const payload_impl &other = dynamic_cast< const payload_impl & >(_other);
-        is_equal = (data_ == other.data_);
+        is_equal = (get_length() == other.get_length()
+                && 0 == std::memcmp(get_data(), other.get_data(), get_length()));
     }
     catch (...) {
         is_equal = false;
@@ -41,35 +46,69 @@ bool payload_impl::operator==(const payload &_other) {
 }
 
 byte_t * payload_impl::get_data() {
-    return data_.data();
+    // The referenced part of the buffer belongs to this payload only
+    return (buffer_ ? const_cast<byte_t *>(view_data_) : data_.data());
 }
 
 const byte_t * payload_impl::get_data() const {
-    return data_.data();
+    return (buffer_ ? view_data_ : data_.data());
 }
 
 length_t payload_impl::get_length() const {
-    return length_t(data_.size());
+    return (buffer_ ? view_length_ : length_t(data_.size()));
 }
 
 void payload_impl::set_capacity(length_t _capacity) {
+    detach();
     data_.reserve(_capacity);
 }
 
 void payload_impl::set_data(const byte_t *_data, const length_t _length) {
+    // _data may point into the referenced buffer
     data_.assign(_data, _data + _length);
+    buffer_.reset();
+    view_data_ = 0;
+    view_length_ = 0;
 }
 
 void payload_impl::set_data(const std::vector< byte_t > &_data) {
-    data_ = _data;
+    data_.assign(_data.begin(), _data.end());
+    buffer_.reset();
+    view_data_ = 0;
+    view_length_ = 0;
+}
+
+void payload_impl::detach() {
+    if (buffer_) {
+        data_.assign(view_data_, view_data_ + view_length_);
+        buffer_.reset();
+        view_data_ = 0;
+        view_length_ = 0;
+    }
 }
 
 bool payload_impl::serialize(serializer *_to) const {
-    return (0 != _to && _to->serialize(data_.data(), uint32_t(data_.size())));
+    return (0 != _to && _to->serialize(get_data(), uint32_t(get_length())));
 }
 
 bool payload_impl::deserialize(deserializer *_from) {
-    return (0 != _from && _from->deserialize(data_));
+    buffer_.reset();
+    if (0 == _from)
+        return false;
+
+    std::size_t its_length = data_.capacity();
+    data_.resize(its_length);
+    return _from->deserialize(data_.data(), its_length);
+}
+
+bool payload_impl::deserialize(deserializer *_from, length_t _length) {
+    data_.clear();
+    if (0 == _from || !_from->deserialize(_length, buffer_, view_data_)) {
+        buffer_.reset();
+        return false;
+    }
+    view_length_ = _length;
+    return true;
 }
 
 } // namespace vsomeip
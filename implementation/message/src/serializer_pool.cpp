@@ -0,0 +1,71 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "../include/deserializer.hpp"
+#include "../include/serializer.hpp"
+#include "../include/serializer_pool.hpp"
+
+namespace vsomeip {
+
+serializer_pool::serializer_pool()
+    : capacity_(0) {
+}
+
+serializer_pool::~serializer_pool() {
+}
+
+void serializer_pool::set_capacity(uint32_t _capacity) {
+    std::lock_guard<std::mutex> its_lock(serializers_mutex_);
+    capacity_ = _capacity;
+    serializers_.clear();
+}
+
+std::shared_ptr<serializer> serializer_pool::get_serializer() {
+    std::shared_ptr<serializer> its_serializer;
+    uint32_t its_capacity;
+    {
+        std::lock_guard<std::mutex> its_lock(serializers_mutex_);
+        if (!serializers_.empty()) {
+            its_serializer = serializers_.back();
+            serializers_.pop_back();
+            return its_serializer;
+        }
+        its_capacity = capacity_;
+    }
+
+    its_serializer = std::make_shared<serializer>();
+    its_serializer->create_data(its_capacity);
+    return its_serializer;
+}
+
+void serializer_pool::put_serializer(
+        const std::shared_ptr<serializer> &_serializer) {
+    _serializer->reset();
+    std::lock_guard<std::mutex> its_lock(serializers_mutex_);
+    if (_serializer->get_capacity() == capacity_)
+        serializers_.push_back(_serializer);
+}
+
+std::shared_ptr<deserializer> serializer_pool::get_deserializer() {
+    {
+        std::lock_guard<std::mutex> its_lock(deserializers_mutex_);
+        if (!deserializers_.empty()) {
+            std::shared_ptr<deserializer> its_deserializer
+                = deserializers_.back();
+            deserializers_.pop_back();
+            return its_deserializer;
+        }
+    }
+    return std::make_shared<deserializer>();
+}
+
+void serializer_pool::put_deserializer(
+        const std::shared_ptr<deserializer> &_deserializer) {
+    _deserializer->reset();
+    std::lock_guard<std::mutex> its_lock(deserializers_mutex_);
+    deserializers_.push_back(_deserializer);
+}
+
+} // namespace vsomeip
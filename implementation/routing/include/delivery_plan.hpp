@@ -0,0 +1,39 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef VSOMEIP_DELIVERY_PLAN_HPP
+#define VSOMEIP_DELIVERY_PLAN_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace vsomeip {
+
+class endpoint;
+class endpoint_definition;
+
+// Receivers of an event, collected over all of its eventgroups. Each
+// local client and each remote target is contained only once. A plan is
+// never modified once it is published, it is replaced by a new one if
+// the routing information changes.
+struct delivery_plan {
+    std::uint32_t generation_;
+
+    // Local subscribers
+    bool is_host_subscribed_;
+    std::shared_ptr<endpoint> host_target_;
+    std::vector<std::shared_ptr<endpoint> > local_targets_;
+
+    // Remote subscribers, grouped by the endpoint that serves them
+    std::shared_ptr<endpoint> reliable_endpoint_;
+    std::vector<std::shared_ptr<endpoint_definition> > reliable_targets_;
+    std::shared_ptr<endpoint> unreliable_endpoint_;
+    std::vector<std::shared_ptr<endpoint_definition> > unreliable_targets_;
+};
+
+} // namespace vsomeip
+
+#endif // VSOMEIP_DELIVERY_PLAN_HPP
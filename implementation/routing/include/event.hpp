@@ -21,6 +21,7 @@ namespace vsomeip {
 
 class endpoint;
 class endpoint_definition;
+struct delivery_plan;
 class message;
 class payload;
 class routing_manager;
@@ -69,6 +70,9 @@ public:
     void add_eventgroup(eventgroup_t _eventgroup);
     void set_eventgroups(const std::set<eventgroup_t> &_eventgroups);
 
+    std::shared_ptr<delivery_plan> get_delivery_plan() const;
+    void set_delivery_plan(const std::shared_ptr<delivery_plan> &_plan);
+
     void notify_one(const std::shared_ptr<endpoint_definition> &_target);
     void notify_one(client_t _client);
 
@@ -96,6 +100,9 @@ private:
 
     std::set<eventgroup_t> eventgroups_;
 
+    // Accessed atomically only
+    std::shared_ptr<delivery_plan> delivery_plan_;
+
     bool is_set_;
     bool is_provided_;
 
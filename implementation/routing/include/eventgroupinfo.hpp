@@ -7,6 +7,7 @@
 #define VSOMEIP_EVENTGROUPINFO_HPP
 
 #include <memory>
+#include <mutex>
 #include <set>
 
 #include <boost/asio/ip/address.hpp>
@@ -57,6 +58,9 @@ private:
 
     std::set<std::shared_ptr<event> > events_;
     std::set<std::shared_ptr<endpoint_definition> > targets_;
+
+    // Delivery plans are built on the I/O threads of the endpoints
+    mutable std::mutex mutex_;
 };
 
 } // namespace vsomeip
@@ -26,6 +26,8 @@ public:
     virtual const std::string & get_name() const = 0;
     virtual std::shared_ptr<configuration> get_configuration() const = 0;
     virtual boost::asio::io_service & get_io() = 0;
+    // I/O service to run the handlers of a new external endpoint on
+    virtual boost::asio::io_service & get_endpoint_io() = 0;
 
     virtual void on_availability(service_t _service, instance_t _instance,
     bool _is_available) const = 0;
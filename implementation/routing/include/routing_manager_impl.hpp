@@ -6,27 +6,36 @@
 #ifndef VSOMEIP_ROUTING_MANAGER_IMPL_HPP
 #define VSOMEIP_ROUTING_MANAGER_IMPL_HPP
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <vector>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <boost/asio/ip/address.hpp>
 #include <boost/asio/io_service.hpp>
+#include <boost/asio/system_timer.hpp>
 
 #include <vsomeip/primitive_types.hpp>
 
 #include "routing_manager.hpp"
 #include "routing_manager_stub_host.hpp"
+#include "../../endpoints/include/buffer.hpp"
 #include "../../endpoints/include/endpoint_host.hpp"
+#include "../../message/include/serializer_pool.hpp"
 #include "../../service_discovery/include/service_discovery_host.hpp"
+#include "../../utility/include/timer_wheel.hpp"
 
 namespace vsomeip {
 
 class client_endpoint;
 class configuration;
+struct delivery_plan;
 class deserializer;
+class endpoint_definition;
 class eventgroupinfo;
 class routing_manager_host;
 class routing_manager_stub;
@@ -145,9 +154,10 @@ public:
             uint16_t _reliable_port,
             const boost::asio::ip::address &_unreliable_address,
             uint16_t _unreliable_port);
+    bool refresh_routing_info(service_t _service, instance_t _instance,
+            ttl_t _ttl);
     void del_routing_info(service_t _service, instance_t _instance,
             bool _has_reliable, bool _has_unreliable);
-    ttl_t update_routing_info(ttl_t _elapsed);
 
     void on_subscribe(service_t _service, instance_t _instance,
             eventgroup_t _eventgroup,
@@ -163,6 +173,10 @@ public:
     void expire_services(const boost::asio::ip::address &_address);
 
 private:
+    void on_discovery_message(message_buffer_ptr_t _buffer,
+            boost::asio::ip::address _sender);
+    std::shared_ptr<endpoint_definition> get_sender(endpoint *_receiver) const;
+
     bool deliver_message(const byte_t *_data, length_t _length,
             instance_t _instance, bool _reliable);
     bool deliver_notification(service_t _service, instance_t _instance,
@@ -171,11 +185,25 @@ private:
             std::shared_ptr<endpoint> &_target, client_t _client,
             const byte_t *_data, uint32_t _size, instance_t _instance,
             bool _flush, bool _reliable) const;
+    bool send_local(
+            std::shared_ptr<endpoint> &_target,
+            const message_buffer_ptr_t &_command, bool _flush) const;
+    message_buffer_ptr_t create_send_command(client_t _client,
+            const byte_t *_data, uint32_t _size, instance_t _instance,
+            bool _flush, bool _reliable) const;
 
     client_t find_local_client(service_t _service, instance_t _instance);
     std::set<client_t> find_local_clients(service_t _service,
             instance_t _instance, eventgroup_t _eventgroup);
     instance_t find_instance(service_t _service, endpoint *_endpoint);
+    void add_service_instance(service_t _service, endpoint *_endpoint,
+            instance_t _instance);
+    void remove_service_instance(service_t _service, endpoint *_endpoint);
+    bool is_specific_endpoint_client(client_t _client) const;
+    std::shared_ptr<endpoint_definition> find_remote_subscriber(client_t _client);
+    bool is_io_thread() const;
+    std::shared_ptr<eventgroupinfo> find_eventgroup_info(service_t _service,
+            instance_t _instance, eventgroup_t _eventgroup) const;
 
     std::shared_ptr<serviceinfo> find_service(service_t _service,
             instance_t _instance) const;
@@ -190,6 +218,8 @@ private:
     void remove_eventgroup_info(service_t _service, instance_t _instance,
             eventgroup_t _eventgroup);
 
+    void publish_services();
+
     std::shared_ptr<endpoint> create_server_endpoint(uint16_t _port,
             bool _reliable, bool _start);
     std::shared_ptr<endpoint> find_server_endpoint(uint16_t _port,
@@ -210,14 +240,23 @@ private:
     std::shared_ptr<endpoint> create_remote_client(service_t _service,
                 instance_t _instance, bool _reliable, client_t _client);
 
+    void set_tp_policy(std::shared_ptr<endpoint> _endpoint,
+            service_t _service, instance_t _instance);
+
     bool deliver_specific_endpoint_message(service_t _service, instance_t _instance,
-            const byte_t *_data, length_t _size, endpoint *_receiver);
+            const byte_t *_data, length_t _size, endpoint *_receiver,
+            bool _reliable);
 
     void clear_client_endpoints(service_t _service, instance_t _instance, bool _reliable);
     void stop_and_delete_client_endpoint(std::shared_ptr<endpoint> _endpoint);
     void clear_multicast_endpoints(service_t _service, instance_t _instance);
     void clear_service_info(service_t _service, instance_t _instance, bool _reliable);
 
+    void update_expiration(service_t _service, instance_t _instance,
+            ttl_t _ttl);
+    void start_ttl_timer();
+    void expire_ttl(const boost::system::error_code &_error);
+
 private:
     void send_subscribe(client_t _client, service_t _service,
             instance_t _instance, eventgroup_t _eventgroup,
@@ -229,18 +268,28 @@ private:
     bool insert_subscription(service_t _service, instance_t _instance,
             eventgroup_t _eventgroup, client_t _client);
 
+    std::shared_ptr<delivery_plan> get_delivery_plan(
+            const std::shared_ptr<event> &_event);
+    std::shared_ptr<delivery_plan> create_delivery_plan(
+            const std::shared_ptr<event> &_event, std::uint32_t _generation);
+    std::atomic<std::uint32_t> & get_plan_generation(service_t _service,
+            instance_t _instance);
+    void invalidate_delivery_plans(service_t _service, instance_t _instance);
+    void invalidate_delivery_plans();
+
     return_code_e check_error(const byte_t *_data, length_t _size,
             instance_t _instance);
 
     void send_error(return_code_e _return_code, const byte_t *_data,
             length_t _size, instance_t _instance, bool _reliable,
-            endpoint *_receiver);
+            const std::shared_ptr<endpoint_definition> &_target);
 
     routing_manager_host *host_;
     boost::asio::io_service &io_;
+    // The thread that runs io_, recorded when the routing manager starts
+    std::atomic<std::thread::id> io_thread_;
 
-    std::shared_ptr<deserializer> deserializer_;
-    std::shared_ptr<serializer> serializer_;
+    serializer_pool serializers_;
 
     std::shared_ptr<configuration> configuration_;
 
@@ -249,47 +298,76 @@ private:
 
     // Routing info
 
+    // Tables that are read on every message are never modified in place.
+    // Updates copy the table under the corresponding mutex and atomically
+    // publish the copy, readers simply load the current table.
+    typedef std::unordered_map<client_t, std::shared_ptr<endpoint> > local_clients_t;
+    typedef std::unordered_map<std::uint32_t, client_t> local_services_t;
+    typedef std::unordered_map<std::uint32_t,
+            std::shared_ptr<serviceinfo> > service_index_t;
+    typedef std::map<service_t,
+            std::map<endpoint *, instance_t> > service_instances_t;
+    // Keyed by the packed service and instance identifiers
+    typedef std::unordered_map<std::uint32_t,
+            std::map<client_t, std::map<bool, std::shared_ptr<endpoint> > > > remote_services_t;
+    // Keyed by the packed service, instance and event identifiers
+    typedef std::unordered_map<std::uint64_t, std::shared_ptr<event> > events_t;
+
     // Local
-    std::map<client_t, std::shared_ptr<endpoint> > local_clients_;
-    std::map<service_t, std::map<instance_t, client_t> > local_services_;
+    std::shared_ptr<const local_clients_t> local_clients_;
+    std::shared_ptr<const local_services_t> local_services_;
 
     // Server endpoints for local services
     std::map<uint16_t, std::map<bool, std::shared_ptr<endpoint> > > server_endpoints_;
-    std::map<service_t, std::map<endpoint *, instance_t> > service_instances_;
+    std::shared_ptr<const service_instances_t> service_instances_;
 
     // Multicast endpoint info (notifications)
+    // Guarded by endpoint_mutex_
     std::map<service_t, std::map<instance_t, std::shared_ptr<endpoint_definition> > > multicast_info;
 
     // Client endpoints for remote services
     std::map<service_t,
             std::map<instance_t, std::map<bool, std::shared_ptr<endpoint_definition> > > > remote_service_info_;
 
-    std::map<service_t,
-            std::map<instance_t, std::map<client_t, std::map<bool, std::shared_ptr<endpoint> > > > >remote_services_;
+    std::shared_ptr<const remote_services_t> remote_services_;
     std::map<boost::asio::ip::address,
             std::map<uint16_t, std::map<bool, std::shared_ptr<endpoint> > > >  client_endpoints_by_ip_;
 
     // Services
     services_t services_;
+    std::shared_ptr<const service_index_t> service_index_;
 
     // Eventgroups
-    std::map<service_t,
-            std::map<instance_t,
-                    std::map<eventgroup_t, std::shared_ptr<eventgroupinfo> > > > eventgroups_;
-    std::map<service_t,
-            std::map<instance_t, std::map<event_t, std::shared_ptr<event> > > > events_;
-    std::map<service_t,
-            std::map<instance_t, std::map<eventgroup_t, std::set<client_t> > > > eventgroup_clients_;
+    std::shared_ptr<const eventgroups_t> eventgroups_;
+    std::shared_ptr<const events_t> events_;
+    // Keyed by the packed service, instance and eventgroup identifiers
+    std::unordered_map<std::uint64_t, std::set<client_t> > eventgroup_clients_;
 
     // Mutexes
     mutable std::recursive_mutex endpoint_mutex_;
     mutable std::mutex local_mutex_;
-    std::mutex serialize_mutex_;
     mutable std::mutex services_mutex_;
     mutable std::mutex eventgroups_mutex_;
+    std::mutex events_mutex_;
+    std::mutex remote_subscribers_mutex_;
 
+    // Delivery plans are outdated as soon as the generation of their
+    // service instance changes. Instances share the generations by their
+    // hash, so a change only outdates the plans of few other instances.
+    std::unique_ptr<std::atomic<std::uint32_t>[]> plan_generations_;
+    std::mutex plan_mutex_;
+
+    // Guarded by remote_subscribers_mutex_
     std::map<client_t, std::shared_ptr<endpoint_definition>> remote_subscriber_map_;
 
+    // Services that were offered with a limited TTL, keyed by the packed
+    // service and instance identifiers
+    timer_wheel<std::uint32_t> ttl_wheel_;
+    boost::asio::system_timer ttl_timer_;
+    bool is_ttl_timer_running_;
+    std::mutex ttl_mutex_;
+
+    // Guarded by endpoint_mutex_
     std::unordered_set<client_t> specific_endpoint_clients;
 };
 
@@ -13,6 +13,7 @@
 
 #include "routing_manager.hpp"
 #include "../../endpoints/include/endpoint_host.hpp"
+#include "../../message/include/serializer_pool.hpp"
 #include <vsomeip/enumeration_types.hpp>
 
 namespace vsomeip {
@@ -133,8 +134,7 @@ private:
 
     std::shared_ptr<configuration> configuration_;
 
-    std::shared_ptr<serializer> serializer_;
-    std::shared_ptr<deserializer> deserializer_;
+    serializer_pool serializers_;
 
     std::shared_ptr<endpoint> sender_;  // --> stub
     std::shared_ptr<endpoint> receiver_;  // --> from everybody
@@ -203,8 +203,6 @@ private:
                 std::shared_ptr<message> > > > pending_notifications_;
 
     std::mutex send_mutex_;
-    std::mutex serialize_mutex_;
-    std::mutex deserialize_mutex_;
     std::mutex pending_mutex_;
 
     std::map<service_t, std::map<instance_t, std::set<event_t> > > fields_;
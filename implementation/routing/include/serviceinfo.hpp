@@ -6,6 +6,7 @@
 #ifndef VSOMEIP_SERVICEINFO_HPP
 #define VSOMEIP_SERVICEINFO_HPP
 
+#include <atomic>
 #include <memory>
 #include <set>
 #include <string>
@@ -56,8 +57,10 @@ private:
 
     major_version_t major_;
     minor_version_t minor_;
-    ttl_t ttl_;
+    // Expired by the routing manager while the I/O threads read it
+    std::atomic<ttl_t> ttl_;
 
+    // Accessed atomically only
     std::shared_ptr<endpoint> reliable_;
     std::shared_ptr<endpoint> unreliable_;
 
@@ -8,11 +8,11 @@
 #include <vsomeip/payload.hpp>
 #include <vsomeip/runtime.hpp>
 
+#include "../include/delivery_plan.hpp"
 #include "../include/event.hpp"
 #include "../include/routing_manager.hpp"
 #include "../../configuration/include/internal.hpp"
 #include "../../logging/include/logger.hpp"
-#include "../../message/include/payload_impl.hpp"
 
 namespace vsomeip {
 
@@ -125,7 +125,7 @@ void event::set_payload(std::shared_ptr<payload> _payload,
 void event::unset_payload() {
     if (is_provided_) {
         is_set_ = false;
-        message_->set_payload(std::make_shared<payload_impl>());
+        message_->set_payload(runtime::get()->create_payload());
     }
 }
 
@@ -163,6 +163,14 @@ void event::set_eventgroups(const std::set<eventgroup_t> &_eventgroups) {
     eventgroups_ = _eventgroups;
 }
 
+std::shared_ptr<delivery_plan> event::get_delivery_plan() const {
+    return std::atomic_load(&delivery_plan_);
+}
+
+void event::set_delivery_plan(const std::shared_ptr<delivery_plan> &_plan) {
+    std::atomic_store(&delivery_plan_, _plan);
+}
+
 void event::update_cbk(boost::system::error_code const &_error) {
     if (!_error) {
         cycle_timer_.expires_from_now(cycle_);
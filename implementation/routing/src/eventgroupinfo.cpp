@@ -21,27 +21,33 @@ eventgroupinfo::~eventgroupinfo() {
 }
 
 major_version_t eventgroupinfo::get_major() const {
+    std::lock_guard<std::mutex> its_lock(mutex_);
     return major_;
 }
 
 void eventgroupinfo::set_major(major_version_t _major) {
+    std::lock_guard<std::mutex> its_lock(mutex_);
     major_ = _major;
 }
 
 ttl_t eventgroupinfo::get_ttl() const {
+    std::lock_guard<std::mutex> its_lock(mutex_);
     return ttl_;
 }
 
 void eventgroupinfo::set_ttl(ttl_t _ttl) {
+    std::lock_guard<std::mutex> its_lock(mutex_);
     ttl_ = _ttl;
 }
 
 bool eventgroupinfo::is_multicast() const {
+    std::lock_guard<std::mutex> its_lock(mutex_);
     return is_multicast_;
 }
 
 bool eventgroupinfo::get_multicast(boost::asio::ip::address &_address,
         uint16_t &_port) const {
+    std::lock_guard<std::mutex> its_lock(mutex_);
     if (is_multicast_) {
         _address = address_;
         _port = port_;
@@ -51,28 +57,34 @@ bool eventgroupinfo::get_multicast(boost::asio::ip::address &_address,
 
 void eventgroupinfo::set_multicast(const boost::asio::ip::address &_address,
         uint16_t _port) {
+    std::lock_guard<std::mutex> its_lock(mutex_);
     address_ = _address;
     port_ = _port;
     is_multicast_ = true;
 }
 
 const std::set<std::shared_ptr<event> > eventgroupinfo::get_events() const {
+    std::lock_guard<std::mutex> its_lock(mutex_);
     return events_;
 }
 
 void eventgroupinfo::add_event(std::shared_ptr<event> _event) {
+    std::lock_guard<std::mutex> its_lock(mutex_);
     events_.insert(_event);
 }
 
 void eventgroupinfo::remove_event(std::shared_ptr<event> _event) {
+    std::lock_guard<std::mutex> its_lock(mutex_);
     events_.erase(_event);
 }
 
 const std::set<std::shared_ptr<endpoint_definition> > eventgroupinfo::get_targets() const {
+    std::lock_guard<std::mutex> its_lock(mutex_);
     return targets_;
 }
 
 bool eventgroupinfo::add_target(std::shared_ptr<endpoint_definition> _target) {
+    std::lock_guard<std::mutex> its_lock(mutex_);
     std::size_t its_size = targets_.size();
     targets_.insert(_target);
     return (its_size != targets_.size());
@@ -80,12 +92,14 @@ bool eventgroupinfo::add_target(std::shared_ptr<endpoint_definition> _target) {
 
 bool eventgroupinfo::remove_target(
         std::shared_ptr<endpoint_definition> _target) {
+    std::lock_guard<std::mutex> its_lock(mutex_);
     std::size_t its_size = targets_.size();
     targets_.erase(_target);
     return (its_size != targets_.size());
 }
 
 void eventgroupinfo::clear_targets() {
+    std::lock_guard<std::mutex> its_lock(mutex_);
     targets_.clear();
 }
 
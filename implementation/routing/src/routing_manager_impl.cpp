@@ -6,12 +6,14 @@
 #include <iomanip>
 #include <memory>
 #include <sstream>
+#include <tuple>
 
 #include <vsomeip/constants.hpp>
 #include <vsomeip/message.hpp>
 #include <vsomeip/payload.hpp>
 #include <vsomeip/runtime.hpp>
 
+#include "../include/delivery_plan.hpp"
 #include "../include/event.hpp"
 #include "../include/eventgroupinfo.hpp"
 #include "../include/routing_manager_host.hpp"
@@ -22,6 +24,7 @@
 #include "../../configuration/include/internal.hpp"
 #include "../../endpoints/include/endpoint_definition.hpp"
 #include "../../endpoints/include/local_client_endpoint_impl.hpp"
+#include "../../endpoints/include/local_shm_client_endpoint_impl.hpp"
 #include "../../endpoints/include/tcp_client_endpoint_impl.hpp"
 #include "../../endpoints/include/tcp_server_endpoint_impl.hpp"
 #include "../../endpoints/include/udp_client_endpoint_impl.hpp"
@@ -42,9 +45,22 @@ namespace vsomeip {
 routing_manager_impl::routing_manager_impl(routing_manager_host *_host) :
         host_(_host),
         io_(_host->get_io()),
-        deserializer_(std::make_shared<deserializer>()),
-        serializer_(std::make_shared<serializer>()),
-        configuration_(host_->get_configuration()) {
+        io_thread_(std::thread::id()),
+        configuration_(host_->get_configuration()),
+        local_clients_(std::make_shared<local_clients_t>()),
+        local_services_(std::make_shared<local_services_t>()),
+        service_instances_(std::make_shared<service_instances_t>()),
+        remote_services_(std::make_shared<remote_services_t>()),
+        service_index_(std::make_shared<service_index_t>()),
+        eventgroups_(std::make_shared<eventgroups_t>()),
+        events_(std::make_shared<events_t>()),
+        plan_generations_(new std::atomic<std::uint32_t>[
+                VSOMEIP_DELIVERY_PLAN_GENERATIONS]),
+        ttl_wheel_(std::chrono::milliseconds(VSOMEIP_DEFAULT_TTL_TICK),
+                VSOMEIP_DEFAULT_TTL_WHEEL_SIZE),
+        ttl_timer_(_host->get_io()), is_ttl_timer_running_(false) {
+    for (std::size_t i = 0; i < VSOMEIP_DELIVERY_PLAN_GENERATIONS; i++)
+        plan_generations_[i] = 0;
 }
 
 routing_manager_impl::~routing_manager_impl() {
@@ -59,7 +75,7 @@ client_t routing_manager_impl::get_client() const {
 }
 
 void routing_manager_impl::init() {
-    serializer_->create_data(configuration_->get_max_message_size_local());
+    serializers_.set_capacity(configuration_->get_max_message_size_local());
 
     // TODO: Only instantiate the stub if needed
     stub_ = std::make_shared<routing_manager_stub>(this, configuration_);
@@ -86,6 +102,9 @@ void routing_manager_impl::init() {
 }
 
 void routing_manager_impl::start() {
+    // The application starts the routing manager on the thread that runs io_
+    io_thread_ = std::this_thread::get_id();
+
     stub_->start();
     if (discovery_)
         discovery_->start();
@@ -99,6 +118,9 @@ void routing_manager_impl::stop() {
     if (discovery_)
         discovery_->stop();
     stub_->stop();
+
+    std::lock_guard<std::mutex> its_lock(ttl_mutex_);
+    ttl_timer_.cancel();
 }
 
 void routing_manager_impl::offer_service(client_t _client, service_t _service,
@@ -106,7 +128,11 @@ void routing_manager_impl::offer_service(client_t _client, service_t _service,
     std::shared_ptr<serviceinfo> its_info;
     {
         std::lock_guard<std::mutex> its_lock(local_mutex_);
-        local_services_[_service][_instance] = _client;
+        std::shared_ptr<local_services_t> its_services
+            = std::make_shared<local_services_t>(*local_services_);
+        (*its_services)[utility::get_key(_service, _instance)] = _client;
+        std::atomic_store(&local_services_,
+                std::shared_ptr<const local_services_t>(its_services));
 
         // Remote route (incoming only)
         its_info = find_service(_service, _instance);
@@ -114,6 +140,7 @@ void routing_manager_impl::offer_service(client_t _client, service_t _service,
             if (its_info->get_major() == _major
                     && its_info->get_minor() == _minor) {
                 its_info->set_ttl(DEFAULT_TTL);
+                update_expiration(_service, _instance, DEFAULT_TTL);
             } else {
                 host_->on_error(error_code_e::SERVICE_PROPERTY_MISMATCH);
             }
@@ -157,8 +184,8 @@ void routing_manager_impl::request_service(client_t _client, service_t _service,
                     DEFAULT_TTL);
     }
 
-    // TODO: Mutex?!
     if (_use_exclusive_proxy) {
+        std::lock_guard<std::recursive_mutex> its_lock(endpoint_mutex_);
         specific_endpoint_clients.insert(_client);
     }
 }
@@ -188,8 +215,7 @@ void routing_manager_impl::subscribe(client_t _client, service_t _service,
             if (0 == find_local_client(_service, _instance)) {
                 client_t subscriber = VSOMEIP_ROUTING_CLIENT;
                 // subscriber != VSOMEIP_ROUTING_CLIENT implies to use its own endpoint
-                auto its_selective = specific_endpoint_clients.find(_client);
-                if (its_selective != specific_endpoint_clients.end()) {
+                if (is_specific_endpoint_client(_client)) {
                     subscriber = _client;
                 }
                 discovery_->subscribe(_service, _instance, _eventgroup,
@@ -198,7 +224,7 @@ void routing_manager_impl::subscribe(client_t _client, service_t _service,
                 send_subscribe(_client, _service, _instance, _eventgroup, _major);
 
                 std::shared_ptr<eventgroupinfo> its_eventgroup
-                    = find_eventgroup(_service, _instance, _eventgroup);
+                    = find_eventgroup_info(_service, _instance, _eventgroup);
                 if (its_eventgroup) {
                     std::set<std::shared_ptr<event> > its_events
                         = its_eventgroup->get_events();
@@ -217,26 +243,23 @@ void routing_manager_impl::subscribe(client_t _client, service_t _service,
 void routing_manager_impl::unsubscribe(client_t _client, service_t _service,
         instance_t _instance, eventgroup_t _eventgroup) {
     if (discovery_) {
-        auto found_service = eventgroup_clients_.find(_service);
-        if (found_service != eventgroup_clients_.end()) {
-            auto found_instance = found_service->second.find(_instance);
-            if (found_instance != found_service->second.end()) {
-                auto found_eventgroup = found_instance->second.find(
-                        _eventgroup);
-                if (found_eventgroup != found_instance->second.end()) {
-                    found_eventgroup->second.erase(_client);
-                    if (0 == found_eventgroup->second.size()) {
-                        eventgroup_clients_.erase(_eventgroup);
-                    }
+        {
+            std::lock_guard<std::mutex> its_lock(eventgroups_mutex_);
+            auto found_eventgroup = eventgroup_clients_.find(
+                    utility::get_key(_service, _instance, _eventgroup));
+            if (found_eventgroup != eventgroup_clients_.end()) {
+                found_eventgroup->second.erase(_client);
+                if (0 == found_eventgroup->second.size()) {
+                    eventgroup_clients_.erase(found_eventgroup);
                 }
             }
         }
+        invalidate_delivery_plans(_service, _instance);
         host_->on_subscription(_service, _instance, _eventgroup, _client, false);
         if (0 == find_local_client(_service, _instance)) {
             client_t subscriber = VSOMEIP_ROUTING_CLIENT;
             // subscriber != VSOMEIP_ROUTING_CLIENT implies to use its own endpoint
-            auto its_selective = specific_endpoint_clients.find(_client);
-            if (its_selective != specific_endpoint_clients.end()) {
+            if (is_specific_endpoint_client(_client)) {
                 subscriber = _client;
             }
             discovery_->unsubscribe(_service, _instance, _eventgroup, subscriber);
@@ -257,15 +280,15 @@ bool routing_manager_impl::send(client_t its_client,
         _message->set_client(its_client);
     }
 
-    std::lock_guard<std::mutex> its_lock(serialize_mutex_);
-    if (serializer_->serialize(_message.get())) {
-        is_sent = send(its_client, serializer_->get_data(),
-                serializer_->get_size(), _message->get_instance(),
+    std::shared_ptr<serializer> its_serializer(serializers_.get_serializer());
+    if (its_serializer->serialize(_message.get())) {
+        is_sent = send(its_client, its_serializer->get_data(),
+                its_serializer->get_size(), _message->get_instance(),
                 _flush, _message->is_reliable());
-        serializer_->reset();
     } else {
         VSOMEIP_ERROR << "Failed to serialize message. Check message size!";
     }
+    serializers_.put_serializer(its_serializer);
 
     return (is_sent);
 }
@@ -312,7 +335,7 @@ bool routing_manager_impl::send(client_t _client, const byte_t *_data,
             } else {
                 if (is_request) {
                     client_t client = VSOMEIP_ROUTING_CLIENT;
-                    if (specific_endpoint_clients.find(its_client) != specific_endpoint_clients.end()) {
+                    if (is_specific_endpoint_client(its_client)) {
                         client = its_client;
                     }
                     its_target = find_or_create_remote_client(its_service, _instance, _reliable, client);
@@ -329,39 +352,35 @@ bool routing_manager_impl::send(client_t _client, const byte_t *_data,
                                     _data[VSOMEIP_METHOD_POS_MAX]);
                             std::shared_ptr<event> its_event = find_event(its_service, _instance, its_method);
                             if (its_event) {
-                                std::vector< byte_t > its_data;
-
-                                for (auto its_group : its_event->get_eventgroups()) {
-                                    // local
-                                    auto its_local_clients = find_local_clients(its_service, _instance, its_group);
-                                    for (auto its_local_client : its_local_clients) {
-                                        // If we also want to receive the message, send it to the routing manager
-                                        // We cannot call deliver_message in this case as this would end in receiving
-                                        // an answer before the call to send has finished.
-                                        if (its_local_client == host_->get_client()) {
-                                            its_local_client = VSOMEIP_ROUTING_CLIENT;
-                                        }
-
-                                        std::shared_ptr<endpoint> its_local_target = find_local(its_local_client);
-                                        if (its_local_target) {
-                                            send_local(its_local_target, _client, _data, _size, _instance, _flush, _reliable);
-                                        }
+                                std::shared_ptr<delivery_plan> its_plan = get_delivery_plan(its_event);
+
+                                // local
+                                // If we also want to receive the message, it is sent to the routing manager
+                                // We cannot call deliver_message in this case as this would end in receiving
+                                // an answer before the call to send has finished.
+                                if (its_plan->host_target_ || !its_plan->local_targets_.empty()) {
+                                    message_buffer_ptr_t its_command
+                                        = create_send_command(_client, _data, _size, _instance, _flush, _reliable);
+                                    if (its_plan->host_target_) {
+                                        send_local(its_plan->host_target_, its_command, _flush);
+                                    }
+                                    for (auto its_local_target : its_plan->local_targets_) {
+                                        send_local(its_local_target, its_command, _flush);
+                                    }
+                                }
+
+                                // remote
+                                if (!its_plan->reliable_targets_.empty()
+                                        || !its_plan->unreliable_targets_.empty()) {
+                                    message_buffer_ptr_t its_buffer
+                                        = std::make_shared<message_buffer_t>(_data, _data + _size);
+                                    for (auto its_remote : its_plan->reliable_targets_) {
+                                        its_plan->reliable_endpoint_->send_to(its_remote, its_buffer);
                                     }
-                                    // we need both endpoints as clients can subscribe to events via TCP and UDP
-                                    std::shared_ptr<endpoint> its_unreliable_target = its_info->get_endpoint(false);
-                                    std::shared_ptr<endpoint> its_reliable_target = its_info->get_endpoint(true);
-                                    if (its_unreliable_target || its_reliable_target) {
-                                        // remote
-                                        auto its_eventgroup = find_eventgroup(its_service, _instance, its_group);
-                                        if (its_eventgroup) {
-                                            for (auto its_remote : its_eventgroup->get_targets()) {
-                                                if(its_remote->is_reliable() && its_reliable_target) {
-                                                    its_reliable_target->send_to(its_remote, _data, _size);
-                                                } else if(its_unreliable_target) {
-                                                    its_unreliable_target->send_to(its_remote, _data, _size);
-                                                }
-                                            }
-                                        }
+                                    // All UDP subscribers are served by a single batch
+                                    if (!its_plan->unreliable_targets_.empty()) {
+                                        its_plan->unreliable_endpoint_->send_to(
+                                                its_plan->unreliable_targets_, its_buffer);
                                     }
                                 }
                             }
@@ -395,41 +414,55 @@ bool routing_manager_impl::send_local(
         const byte_t *_data, uint32_t _size,
         instance_t _instance,
         bool _flush, bool _reliable) const {
+    return send_local(_target,
+            create_send_command(_client, _data, _size, _instance,
+                    _flush, _reliable),
+            _flush);
+}
 
-    std::lock_guard<std::recursive_mutex> its_lock(endpoint_mutex_);
+bool routing_manager_impl::send_local(
+        std::shared_ptr<endpoint>& _target,
+        const message_buffer_ptr_t &_command, bool _flush) const {
+    return _target->send(_command, _flush);
+}
 
-    std::vector<byte_t> its_command(
+message_buffer_ptr_t routing_manager_impl::create_send_command(
+        client_t _client, const byte_t *_data, uint32_t _size,
+        instance_t _instance, bool _flush, bool _reliable) const {
+    message_buffer_ptr_t its_command = std::make_shared<message_buffer_t>(
             VSOMEIP_COMMAND_HEADER_SIZE + _size + sizeof(instance_t)
                     + sizeof(bool) + sizeof(bool));
-    its_command[VSOMEIP_COMMAND_TYPE_POS] = VSOMEIP_SEND;
-    std::memcpy(&its_command[VSOMEIP_COMMAND_CLIENT_POS], &_client,
+    byte_t *its_data = &(*its_command)[0];
+
+    its_data[VSOMEIP_COMMAND_TYPE_POS] = VSOMEIP_SEND;
+    std::memcpy(&its_data[VSOMEIP_COMMAND_CLIENT_POS], &_client,
             sizeof(client_t));
-    std::memcpy(&its_command[VSOMEIP_COMMAND_SIZE_POS_MIN], &_size,
+    std::memcpy(&its_data[VSOMEIP_COMMAND_SIZE_POS_MIN], &_size,
             sizeof(_size));
-    std::memcpy(&its_command[VSOMEIP_COMMAND_PAYLOAD_POS], _data,
+    std::memcpy(&its_data[VSOMEIP_COMMAND_PAYLOAD_POS], _data,
             _size);
-    std::memcpy(&its_command[VSOMEIP_COMMAND_PAYLOAD_POS + _size],
+    std::memcpy(&its_data[VSOMEIP_COMMAND_PAYLOAD_POS + _size],
             &_instance, sizeof(instance_t));
-    std::memcpy(&its_command[VSOMEIP_COMMAND_PAYLOAD_POS + _size
+    std::memcpy(&its_data[VSOMEIP_COMMAND_PAYLOAD_POS + _size
             + sizeof(instance_t)], &_flush, sizeof(bool));
-    std::memcpy(&its_command[VSOMEIP_COMMAND_PAYLOAD_POS + _size
+    std::memcpy(&its_data[VSOMEIP_COMMAND_PAYLOAD_POS + _size
             + sizeof(instance_t) + sizeof(bool)], &_reliable, sizeof(bool));
 
-    return _target->send(&its_command[0], uint32_t(its_command.size()), _flush);
+    return its_command;
 }
 
 bool routing_manager_impl::send_to(
         const std::shared_ptr<endpoint_definition> &_target,
         std::shared_ptr<message> _message) {
     bool is_sent(false);
-    std::lock_guard<std::mutex> its_lock(serialize_mutex_);
-    if (serializer_->serialize(_message.get())) {
+    std::shared_ptr<serializer> its_serializer(serializers_.get_serializer());
+    if (its_serializer->serialize(_message.get())) {
         is_sent = send_to(_target,
-                serializer_->get_data(), serializer_->get_size());
-        serializer_->reset();
+                its_serializer->get_data(), its_serializer->get_size());
     } else {
         VSOMEIP_ERROR<< "routing_manager_impl::send_to: serialization failed.";
     }
+    serializers_.put_serializer(its_serializer);
     return (is_sent);
 }
 
@@ -486,15 +519,28 @@ void routing_manager_impl::register_event(client_t _client,
 
     for (auto eg : _eventgroups) {
         std::shared_ptr<eventgroupinfo> its_eventgroup_info
-            = find_eventgroup(_service, _instance, eg);
+            = find_eventgroup_info(_service, _instance, eg);
         if (!its_eventgroup_info) {
             its_eventgroup_info = std::make_shared<eventgroupinfo>();
-            eventgroups_[_service][_instance][eg] = its_eventgroup_info;
+            std::lock_guard<std::mutex> its_lock(eventgroups_mutex_);
+            std::shared_ptr<eventgroups_t> its_eventgroups
+                = std::make_shared<eventgroups_t>(*eventgroups_);
+            (*its_eventgroups)[_service][_instance][eg] = its_eventgroup_info;
+            std::atomic_store(&eventgroups_,
+                    std::shared_ptr<const eventgroups_t>(its_eventgroups));
         }
         its_eventgroup_info->add_event(its_event);
     }
 
-    events_[_service][_instance][_event] = its_event;
+    {
+        std::lock_guard<std::mutex> its_lock(events_mutex_);
+        std::shared_ptr<events_t> its_events
+            = std::make_shared<events_t>(*events_);
+        (*its_events)[utility::get_key(_service, _instance, _event)] = its_event;
+        std::atomic_store(&events_,
+                std::shared_ptr<const events_t>(its_events));
+    }
+    invalidate_delivery_plans(_service, _instance);
 }
 
 void routing_manager_impl::unregister_event(client_t _client,
@@ -502,32 +548,32 @@ void routing_manager_impl::unregister_event(client_t _client,
         event_t _event, bool _is_provided) {
     (void)_client;
 
-    auto found_service = events_.find(_service);
-    if (found_service != events_.end()) {
-        auto found_instance = found_service->second.find(_instance);
-        if (found_instance != found_service->second.end()) {
-            auto found_event = found_instance->second.find(_event);
-            if (found_event != found_instance->second.end()) {
-                auto its_event = found_event->second;
-                if (!its_event->remove_ref()) {
-                    auto its_eventgroups = its_event->get_eventgroups();
-                    for (auto eg : its_eventgroups) {
-                        std::shared_ptr<eventgroupinfo> its_eventgroup_info
-                            = find_eventgroup(_service, _instance, eg);
-                        if (its_eventgroup_info) {
-                            its_eventgroup_info->remove_event(its_event);
-                            if (0 == its_eventgroup_info->get_events().size()) {
-                                remove_eventgroup_info(_service, _instance, eg);
-                            }
-                        }
+    std::unique_lock<std::mutex> its_lock(events_mutex_);
+    std::shared_ptr<event> its_event = find_event(_service, _instance, _event);
+    if (its_event) {
+        if (!its_event->remove_ref()) {
+            auto its_eventgroups = its_event->get_eventgroups();
+            for (auto eg : its_eventgroups) {
+                std::shared_ptr<eventgroupinfo> its_eventgroup_info
+                    = find_eventgroup_info(_service, _instance, eg);
+                if (its_eventgroup_info) {
+                    its_eventgroup_info->remove_event(its_event);
+                    if (0 == its_eventgroup_info->get_events().size()) {
+                        remove_eventgroup_info(_service, _instance, eg);
                     }
-                    found_instance->second.erase(_event);
-                } else if (_is_provided) {
-                    its_event->set_provided(false);
                 }
             }
+            std::shared_ptr<events_t> its_events
+                = std::make_shared<events_t>(*events_);
+            its_events->erase(utility::get_key(_service, _instance, _event));
+            std::atomic_store(&events_,
+                    std::shared_ptr<const events_t>(its_events));
+        } else if (_is_provided) {
+            its_event->set_provided(false);
         }
     }
+    its_lock.unlock();
+    invalidate_delivery_plans(_service, _instance);
 }
 
 void routing_manager_impl::notify(
@@ -549,11 +595,12 @@ void routing_manager_impl::notify_one(service_t _service, instance_t _instance,
     std::shared_ptr<event> its_event = find_event(_service, _instance, _event);
     if (its_event) {
         for (auto its_group : its_event->get_eventgroups()) {
-            auto its_eventgroup = find_eventgroup(_service, _instance, its_group);
+            auto its_eventgroup = find_eventgroup_info(_service, _instance, its_group);
             if (its_eventgroup) {
-                auto its_subscriber = remote_subscriber_map_.find(_client);
-                if (its_subscriber != remote_subscriber_map_.end()) {
-                    its_event->set_payload(_payload, its_subscriber->second);
+                std::shared_ptr<endpoint_definition> its_subscriber
+                    = find_remote_subscriber(_client);
+                if (its_subscriber) {
+                    its_event->set_payload(_payload, its_subscriber);
                 } else {
                     its_event->set_payload(_payload, _client);
                 }
@@ -574,9 +621,13 @@ void routing_manager_impl::on_error(const byte_t *_data, length_t _length, endpo
         its_instance = find_instance(its_service, _receiver);
     }
     send_error(return_code_e::E_MALFORMED_MESSAGE, _data, _length,
-            its_instance, _receiver->is_reliable(), _receiver);
+            its_instance, _receiver->is_reliable(), get_sender(_receiver));
 }
 
+// External endpoints may run on the I/O threads of the application. Their
+// messages are routed on these threads within the receive handler, so the
+// receiver is alive and may be asked for the sender. The routing tables
+// are either published as snapshots or locked.
 void routing_manager_impl::on_message(const byte_t *_data, length_t _size,
         endpoint *_receiver) {
 #if 0
@@ -594,31 +645,59 @@ void routing_manager_impl::on_message(const byte_t *_data, length_t _size,
             if (discovery_) {
                 boost::asio::ip::address its_address;
                 if (_receiver->get_remote_address(its_address)) {
-                    discovery_->on_message(_data, _size, its_address);
+                    if (is_io_thread()) {
+                        discovery_->on_message(_data, _size, its_address);
+                    } else {
+                        // The Service Discovery must not be entered concurrently
+                        io_.post(std::bind(
+                                &routing_manager_impl::on_discovery_message,
+                                shared_from_this(),
+                                std::make_shared<message_buffer_t>(
+                                        _data, _data + _size),
+                                its_address));
+                    }
                 } else {
                     VSOMEIP_ERROR << "Ignored SD message from unknown address.";
                 }
             }
         } else {
+            bool is_reliable = _receiver->is_reliable();
             instance_t its_instance = find_instance(its_service, _receiver);
             return_code_e return_code = check_error(_data, _size, its_instance);
             if (return_code != return_code_e::E_OK) {
                 if (return_code != return_code_e::E_NOT_OK) {
                     send_error(return_code, _data, _size, its_instance,
-                            _receiver->is_reliable(), _receiver);
+                            is_reliable, get_sender(_receiver));
                 }
                 return;
             }
 
-            if (!deliver_specific_endpoint_message(
-                    its_service, its_instance, _data, _size, _receiver)) {
+            if (!deliver_specific_endpoint_message(its_service, its_instance,
+                    _data, _size, _receiver, is_reliable)) {
                 // Common way of message handling
-                on_message(its_service, its_instance, _data, _size, _receiver->is_reliable());
+                on_message(its_service, its_instance, _data, _size, is_reliable);
             }
         }
     }
 }
 
+void routing_manager_impl::on_discovery_message(message_buffer_ptr_t _buffer,
+        boost::asio::ip::address _sender) {
+    discovery_->on_message(&(*_buffer)[0], length_t(_buffer->size()), _sender);
+}
+
+std::shared_ptr<endpoint_definition> routing_manager_impl::get_sender(
+        endpoint *_receiver) const {
+    std::shared_ptr<endpoint_definition> its_sender;
+    boost::asio::ip::address its_address;
+    if (_receiver->get_remote_address(its_address)) {
+        its_sender = std::make_shared<endpoint_definition>(its_address,
+                _receiver->get_remote_port(), _receiver->is_reliable());
+        its_sender->set_remote_port(_receiver->get_local_port());
+    }
+    return its_sender;
+}
+
 void routing_manager_impl::on_message(
         service_t _service, instance_t _instance,
         const byte_t *_data, length_t _size,
@@ -649,9 +728,10 @@ void routing_manager_impl::on_message(
         const_cast<byte_t *>(_data)[VSOMEIP_CLIENT_POS_MIN] = 0;
         const_cast<byte_t *>(_data)[VSOMEIP_CLIENT_POS_MAX] = 0;
 
-        auto it_subscriber = remote_subscriber_map_.find(its_client);
-        if (it_subscriber != remote_subscriber_map_.end()) {
-            send_to(it_subscriber->second, _data, _size);
+        std::shared_ptr<endpoint_definition> its_subscriber
+            = find_remote_subscriber(its_client);
+        if (its_subscriber) {
+            send_to(its_subscriber, _data, _size);
         } else {
             if (its_client == host_->get_client()) {
                 deliver_message(_data, _size, _instance, _reliable);
@@ -696,19 +776,20 @@ void routing_manager_impl::on_message(
                     its_response->set_message_type(message_type_e::MT_ERROR);
                 }
 
-                std::lock_guard<std::mutex> its_lock(serialize_mutex_);
-                if (serializer_->serialize(its_response.get())) {
+                std::shared_ptr<serializer> its_serializer(
+                        serializers_.get_serializer());
+                if (its_serializer->serialize(its_response.get())) {
                     // always pass reliable = false, but this won't be used, as
                     // the event is sent out via TCP or UDP dependent on which
                     // L4Proto the subscriber passed in the endpoint option in
                     // its subscription to the eventgroup
                     send(its_client,
-                        serializer_->get_data(), serializer_->get_size(),
+                        its_serializer->get_data(), its_serializer->get_size(),
                         _instance, true, false);
                 } else {
                     VSOMEIP_ERROR << "routing_manager_impl::on_message: serialization error.";
                 }
-                serializer_->reset();
+                serializers_.put_serializer(its_serializer);
             }
             return;
         } else {
@@ -753,25 +834,33 @@ void routing_manager_impl::on_notification(client_t _client,
 }
 
 void routing_manager_impl::on_connect(std::shared_ptr<endpoint> _endpoint) {
+    if (!is_io_thread()) {
+        io_.post(std::bind(&routing_manager_impl::on_connect,
+                shared_from_this(), _endpoint));
+        return;
+    }
+
     // Is called when endpoint->connect succeded!
-    for (auto &its_service : remote_services_) {
-        for (auto &its_instance : its_service.second) {
-            for (auto &its_client : its_instance.second) {
-                if (its_client.first == VSOMEIP_ROUTING_CLIENT ||
-                        its_client.first == get_client()) {
-                    auto found_endpoint = its_client.second.find(false);
-                    if (found_endpoint != its_client.second.end()) {
-                        if (found_endpoint->second.get() == _endpoint.get()) {
-                            host_->on_availability(its_service.first, its_instance.first,
-                                    true);
-                        }
+    std::shared_ptr<const remote_services_t> its_remote_services
+        = std::atomic_load(&remote_services_);
+    for (auto &its_instance : *its_remote_services) {
+        service_t its_service = service_t(its_instance.first >> 16);
+        instance_t its_instance_id = instance_t(its_instance.first & 0xFFFF);
+        for (auto &its_client : its_instance.second) {
+            if (its_client.first == VSOMEIP_ROUTING_CLIENT ||
+                    its_client.first == get_client()) {
+                auto found_endpoint = its_client.second.find(false);
+                if (found_endpoint != its_client.second.end()) {
+                    if (found_endpoint->second.get() == _endpoint.get()) {
+                        host_->on_availability(its_service, its_instance_id,
+                                true);
                     }
-                    found_endpoint = its_client.second.find(true);
-                    if (found_endpoint != its_client.second.end()) {
-                        if (found_endpoint->second.get() == _endpoint.get()) {
-                            host_->on_availability(its_service.first,
-                                    its_instance.first, true);
-                        }
+                }
+                found_endpoint = its_client.second.find(true);
+                if (found_endpoint != its_client.second.end()) {
+                    if (found_endpoint->second.get() == _endpoint.get()) {
+                        host_->on_availability(its_service,
+                                its_instance_id, true);
                     }
                 }
             }
@@ -780,25 +869,33 @@ void routing_manager_impl::on_connect(std::shared_ptr<endpoint> _endpoint) {
 }
 
 void routing_manager_impl::on_disconnect(std::shared_ptr<endpoint> _endpoint) {
+    if (!is_io_thread()) {
+        io_.post(std::bind(&routing_manager_impl::on_disconnect,
+                shared_from_this(), _endpoint));
+        return;
+    }
+
     // Is called when endpoint->connect fails!
-    for (auto &its_service : remote_services_) {
-        for (auto &its_instance : its_service.second) {
-            for (auto &its_client : its_instance.second) {
-                if (its_client.first == VSOMEIP_ROUTING_CLIENT ||
-                        its_client.first == get_client()) {
-                    auto found_endpoint = its_client.second.find(false);
-                    if (found_endpoint != its_client.second.end()) {
-                        if (found_endpoint->second.get() == _endpoint.get()) {
-                            host_->on_availability(its_service.first, its_instance.first,
-                                    false);
-                        }
+    std::shared_ptr<const remote_services_t> its_remote_services
+        = std::atomic_load(&remote_services_);
+    for (auto &its_instance : *its_remote_services) {
+        service_t its_service = service_t(its_instance.first >> 16);
+        instance_t its_instance_id = instance_t(its_instance.first & 0xFFFF);
+        for (auto &its_client : its_instance.second) {
+            if (its_client.first == VSOMEIP_ROUTING_CLIENT ||
+                    its_client.first == get_client()) {
+                auto found_endpoint = its_client.second.find(false);
+                if (found_endpoint != its_client.second.end()) {
+                    if (found_endpoint->second.get() == _endpoint.get()) {
+                        host_->on_availability(its_service, its_instance_id,
+                                false);
                     }
-                    found_endpoint = its_client.second.find(true);
-                    if (found_endpoint != its_client.second.end()) {
-                        if (found_endpoint->second.get() == _endpoint.get()) {
-                            host_->on_availability(its_service.first,
-                                    its_instance.first, false);
-                        }
+                }
+                found_endpoint = its_client.second.find(true);
+                if (found_endpoint != its_client.second.end()) {
+                    if (found_endpoint->second.get() == _endpoint.get()) {
+                        host_->on_availability(its_service,
+                                its_instance_id, false);
                     }
                 }
             }
@@ -809,10 +906,9 @@ void routing_manager_impl::on_disconnect(std::shared_ptr<endpoint> _endpoint) {
 void routing_manager_impl::on_stop_offer_service(service_t _service,
         instance_t _instance) {
 
-    for (auto &s : events_)
-        for (auto &i : s.second)
-            for (auto &e : i.second)
-                e.second->unset_payload();
+    std::shared_ptr<const events_t> its_events = std::atomic_load(&events_);
+    for (auto &e : *its_events)
+        e.second->unset_payload();
 
     /**
      * Hold reliable & unreliable server-endpoints from service info
@@ -831,13 +927,10 @@ void routing_manager_impl::on_stop_offer_service(service_t _service,
 
     // Trigger "del_routing_info" either over SD or static
     if (discovery_) {
-        auto found_service = services_.find(_service);
-        if (found_service != services_.end()) {
-            auto found_instance = found_service->second.find(_instance);
-            if (found_instance != found_service->second.end()) {
-                found_instance->second->set_ttl(0);
-                discovery_->on_offer_change();
-            }
+        if (its_info) {
+            its_info->set_ttl(0);
+            update_expiration(_service, _instance, 0);
+            discovery_->on_offer_change();
         }
     } else {
         del_routing_info(_service, _instance,
@@ -869,11 +962,7 @@ void routing_manager_impl::on_stop_offer_service(service_t _service,
             bool isLastService = (its_endpoint->get_use_count() == 0);
 
             // Clear service_instances_
-            if (1 >= service_instances_[_service].size()) {
-                service_instances_.erase(_service);
-            } else {
-                service_instances_[_service].erase(its_endpoint.get());
-            }
+            remove_service_instance(_service, its_endpoint.get());
 
             // Clear server endpoint if no service remains using it
             if (isLastService) {
@@ -901,8 +990,13 @@ void routing_manager_impl::on_stop_offer_service(service_t _service,
 bool routing_manager_impl::deliver_message(const byte_t *_data, length_t _size,
         instance_t _instance, bool _reliable) {
     bool is_delivered(false);
-    deserializer_->set_data(_data, _size);
-    std::shared_ptr<message> its_message(deserializer_->deserialize_message());
+
+    std::shared_ptr<deserializer> its_deserializer(
+            serializers_.get_deserializer());
+    its_deserializer->set_data(_data, _size);
+    std::shared_ptr<message> its_message(
+            its_deserializer->deserialize_message());
+    serializers_.put_deserializer(its_deserializer);
     if (its_message) {
         its_message->set_instance(_instance);
         its_message->set_reliable(_reliable);
@@ -929,65 +1023,71 @@ bool routing_manager_impl::deliver_notification(
 
     std::shared_ptr<event> its_event = find_event(_service, _instance, its_method);
     if (its_event) {
-        std::vector< byte_t > its_data;
-
-        for (auto its_group : its_event->get_eventgroups()) {
-            auto its_local_clients = find_local_clients(_service, _instance, its_group);
-            for (auto its_local_client : its_local_clients) {
-                if (its_local_client == host_->get_client()) {
-                    deliver_message(_data, _length, _instance, _reliable);
-                } else {
-                    std::shared_ptr<endpoint> its_local_target = find_local(its_local_client);
-                    if (its_local_target) {
-                        send_local(its_local_target, VSOMEIP_ROUTING_CLIENT,
-                                _data, _length, _instance, true, _reliable);
-                    }
-                }
-            }
+        std::shared_ptr<delivery_plan> its_plan = get_delivery_plan(its_event);
+        if (its_plan->is_host_subscribed_) {
+            deliver_message(_data, _length, _instance, _reliable);
+        }
+        for (auto its_local_target : its_plan->local_targets_) {
+            send_local(its_local_target, VSOMEIP_ROUTING_CLIENT,
+                    _data, _length, _instance, true, _reliable);
         }
     }
 
     return is_delivered;
 }
 
+// Called by the Service Discovery and from its callbacks, which all run on
+// io_. Only this thread updates the eventgroup from its service info; the
+// routing itself only reads the targets through find_eventgroup_info.
 std::shared_ptr<eventgroupinfo> routing_manager_impl::find_eventgroup(
         service_t _service, instance_t _instance,
         eventgroup_t _eventgroup) const {
-    std::lock_guard<std::mutex> its_lock(eventgroups_mutex_);
+    std::shared_ptr<eventgroupinfo> its_info
+        = find_eventgroup_info(_service, _instance, _eventgroup);
+    if (its_info) {
+        std::shared_ptr<serviceinfo> its_service_info
+            = find_service(_service, _instance);
+        if (its_service_info) {
+            if (_eventgroup
+                    == its_service_info->get_multicast_group()) {
+                try {
+                    boost::asio::ip::address its_multicast_address =
+                            boost::asio::ip::address::from_string(
+                                    its_service_info->get_multicast_address());
+                    uint16_t its_multicast_port =
+                            its_service_info->get_multicast_port();
+                    its_info->set_multicast(its_multicast_address,
+                            its_multicast_port);
+                }
+                catch (...) {
+                    VSOMEIP_ERROR << "Eventgroup ["
+                            << std::hex << std::setw(4) << std::setfill('0')
+                            << _service << "." << _instance << "." << _eventgroup
+                            << "] is configured as multicast, but no valid "
+                               "multicast address is configured!";
+                }
+            }
+            its_info->set_major(its_service_info->get_major());
+            its_info->set_ttl(its_service_info->get_ttl());
+        }
+    }
+    return (its_info);
+}
+
+std::shared_ptr<eventgroupinfo> routing_manager_impl::find_eventgroup_info(
+        service_t _service, instance_t _instance,
+        eventgroup_t _eventgroup) const {
+    std::shared_ptr<const eventgroups_t> its_eventgroups
+        = std::atomic_load(&eventgroups_);
 
     std::shared_ptr<eventgroupinfo> its_info(nullptr);
-    auto found_service = eventgroups_.find(_service);
-    if (found_service != eventgroups_.end()) {
+    auto found_service = its_eventgroups->find(_service);
+    if (found_service != its_eventgroups->end()) {
         auto found_instance = found_service->second.find(_instance);
         if (found_instance != found_service->second.end()) {
             auto found_eventgroup = found_instance->second.find(_eventgroup);
             if (found_eventgroup != found_instance->second.end()) {
                 its_info = found_eventgroup->second;
-                std::shared_ptr<serviceinfo> its_service_info
-                    = find_service(_service, _instance);
-                if (its_service_info) {
-                    if (_eventgroup
-                            == its_service_info->get_multicast_group()) {
-                        try {
-                            boost::asio::ip::address its_multicast_address =
-                                    boost::asio::ip::address::from_string(
-                                            its_service_info->get_multicast_address());
-                            uint16_t its_multicast_port =
-                                    its_service_info->get_multicast_port();
-                            its_info->set_multicast(its_multicast_address,
-                                    its_multicast_port);
-                        }
-                        catch (...) {
-                            VSOMEIP_ERROR << "Eventgroup ["
-                                    << std::hex << std::setw(4) << std::setfill('0')
-                                    << _service << "." << _instance << "." << _eventgroup
-                                    << "] is configured as multicast, but no valid "
-                                       "multicast address is configured!";
-                        }
-                    }
-                    its_info->set_major(its_service_info->get_major());
-                    its_info->set_ttl(its_service_info->get_ttl());
-                }
             }
         }
     }
@@ -997,13 +1097,17 @@ std::shared_ptr<eventgroupinfo> routing_manager_impl::find_eventgroup(
 void routing_manager_impl::remove_eventgroup_info(service_t _service,
         instance_t _instance, eventgroup_t _eventgroup) {
     std::lock_guard<std::mutex> its_lock(eventgroups_mutex_);
-    auto found_service = eventgroups_.find(_service);
-    if (found_service != eventgroups_.end()) {
+    std::shared_ptr<eventgroups_t> its_eventgroups
+        = std::make_shared<eventgroups_t>(*eventgroups_);
+    auto found_service = its_eventgroups->find(_service);
+    if (found_service != its_eventgroups->end()) {
         auto found_instance = found_service->second.find(_instance);
         if (found_instance != found_service->second.end()) {
             found_instance->second.erase(_eventgroup);
         }
     }
+    std::atomic_store(&eventgroups_,
+            std::shared_ptr<const eventgroups_t>(its_eventgroups));
 }
 
 std::shared_ptr<configuration> routing_manager_impl::get_configuration() const {
@@ -1024,7 +1128,11 @@ std::shared_ptr<endpoint> routing_manager_impl::create_service_discovery_endpoin
             its_info->set_endpoint(its_service_endpoint, _reliable);
 
             // routing info
-            services_[VSOMEIP_SD_SERVICE][VSOMEIP_SD_INSTANCE] = its_info;
+            {
+                std::lock_guard<std::mutex> its_lock(services_mutex_);
+                services_[VSOMEIP_SD_SERVICE][VSOMEIP_SD_INSTANCE] = its_info;
+                publish_services();
+            }
 
             its_service_endpoint->add_multicast(VSOMEIP_SD_SERVICE,
                     VSOMEIP_SD_METHOD, _address, _port);
@@ -1067,17 +1175,27 @@ std::shared_ptr<endpoint> routing_manager_impl::find_or_create_remote_client(
 std::shared_ptr<serviceinfo> routing_manager_impl::find_service(
         service_t _service, instance_t _instance) const {
     std::shared_ptr<serviceinfo> its_info;
-    std::lock_guard<std::mutex> its_lock(services_mutex_);
-    auto found_service = services_.find(_service);
-    if (found_service != services_.end()) {
-        auto found_instance = found_service->second.find(_instance);
-        if (found_instance != found_service->second.end()) {
-            its_info = found_instance->second;
-        }
+    std::shared_ptr<const service_index_t> its_index
+        = std::atomic_load(&service_index_);
+    auto found_service = its_index->find(utility::get_key(_service, _instance));
+    if (found_service != its_index->end()) {
+        its_info = found_service->second;
     }
     return (its_info);
 }
 
+void routing_manager_impl::publish_services() {
+    std::shared_ptr<service_index_t> its_index
+        = std::make_shared<service_index_t>();
+    for (auto &s : services_) {
+        for (auto &i : s.second) {
+            (*its_index)[utility::get_key(s.first, i.first)] = i.second;
+        }
+    }
+    std::atomic_store(&service_index_,
+            std::shared_ptr<const service_index_t>(its_index));
+}
+
 std::shared_ptr<serviceinfo> routing_manager_impl::create_service_info(
         service_t _service, instance_t _instance, major_version_t _major,
         minor_version_t _minor, ttl_t _ttl, bool _is_local_service) {
@@ -1091,6 +1209,10 @@ std::shared_ptr<serviceinfo> routing_manager_impl::create_service_info(
                 _service, _instance);
 
         bool is_someip = configuration_->is_someip(_service, _instance);
+        uint32_t its_max_flush_delay
+            = configuration_->get_max_flush_delay(_service, _instance);
+        uint32_t its_max_flush_bytes
+            = configuration_->get_max_flush_bytes(_service, _instance);
 
         its_info->set_multicast_address(
                 configuration_->get_multicast_address(_service, _instance));
@@ -1108,10 +1230,12 @@ std::shared_ptr<serviceinfo> routing_manager_impl::create_service_info(
                 its_reliable_endpoint = find_or_create_server_endpoint(
                         its_reliable_port, true, is_someip);
                 if (its_reliable_endpoint) {
+                    its_reliable_endpoint->set_flush_policy(_service,
+                            its_max_flush_delay, its_max_flush_bytes);
                     its_info->set_endpoint(its_reliable_endpoint, true);
                     its_reliable_endpoint->increment_use_count();
-                    service_instances_[_service][its_reliable_endpoint.get()] =
-                            _instance;
+                    add_service_instance(_service,
+                            its_reliable_endpoint.get(), _instance);
                 }
             }
 
@@ -1119,10 +1243,13 @@ std::shared_ptr<serviceinfo> routing_manager_impl::create_service_info(
                 its_unreliable_endpoint = find_or_create_server_endpoint(
                         its_unreliable_port, false, is_someip);
                 if (its_unreliable_endpoint) {
+                    its_unreliable_endpoint->set_flush_policy(_service,
+                            its_max_flush_delay, its_max_flush_bytes);
+                    set_tp_policy(its_unreliable_endpoint, _service, _instance);
                     its_info->set_endpoint(its_unreliable_endpoint, false);
                     its_unreliable_endpoint->increment_use_count();
-                    service_instances_[_service][its_unreliable_endpoint.get()] =
-                            _instance;
+                    add_service_instance(_service,
+                            its_unreliable_endpoint.get(), _instance);
                 }
             }
 
@@ -1137,7 +1264,9 @@ std::shared_ptr<serviceinfo> routing_manager_impl::create_service_info(
         {
             std::lock_guard<std::mutex> its_lock(services_mutex_);
             services_[_service][_instance] = its_info;
+            publish_services();
         }
+        invalidate_delivery_plans(_service, _instance);
     } else {
         host_->on_error(error_code_e::CONFIGURATION_MISSING);
     }
@@ -1152,10 +1281,11 @@ std::shared_ptr<endpoint> routing_manager_impl::create_client_endpoint(
 
     std::shared_ptr<endpoint> its_endpoint;
     try {
+        boost::asio::io_service &its_io = host_->get_endpoint_io();
         if (_reliable) {
             its_endpoint = std::make_shared<tcp_client_endpoint_impl>(
                     shared_from_this(),
-                    boost::asio::ip::tcp::endpoint(_address, _port), io_,
+                    boost::asio::ip::tcp::endpoint(_address, _port), its_io,
                     configuration_->get_message_size_reliable(
                             _address.to_string(), _port));
 
@@ -1166,7 +1296,7 @@ std::shared_ptr<endpoint> routing_manager_impl::create_client_endpoint(
         } else {
             its_endpoint = std::make_shared<udp_client_endpoint_impl>(
                     shared_from_this(),
-                    boost::asio::ip::udp::endpoint(_address, _port), io_);
+                    boost::asio::ip::udp::endpoint(_address, _port), its_io);
         }
         if (_start)
             its_endpoint->start();
@@ -1184,10 +1314,14 @@ std::shared_ptr<endpoint> routing_manager_impl::create_server_endpoint(
     try {
         boost::asio::ip::address its_unicast = configuration_->get_unicast_address();
         if (_start) {
+            // The Service Discovery shares its thread with the timers
+            boost::asio::io_service &its_io
+                = (_port == configuration_->get_sd_port() ?
+                        io_ : host_->get_endpoint_io());
             if (_reliable) {
                 its_endpoint = std::make_shared<tcp_server_endpoint_impl>(
                         shared_from_this(),
-                        boost::asio::ip::tcp::endpoint(its_unicast, _port), io_,
+                        boost::asio::ip::tcp::endpoint(its_unicast, _port), its_io,
                         configuration_->get_message_size_reliable(
                                 its_unicast.to_string(), _port));
                 if (configuration_->has_enabled_magic_cookies(
@@ -1203,9 +1337,14 @@ std::shared_ptr<endpoint> routing_manager_impl::create_server_endpoint(
                     its_unicast = boost::asio::ip::address_v6::any();
                 }
                 boost::asio::ip::udp::endpoint ep(its_unicast, _port);
-                its_endpoint = std::make_shared<udp_server_endpoint_impl>(
-                        shared_from_this(),
-                        ep, io_);
+                std::shared_ptr<udp_server_endpoint_impl> its_udp_endpoint
+                    = std::make_shared<udp_server_endpoint_impl>(
+                            shared_from_this(), ep, its_io);
+                if (configuration_->is_io_uring_enabled()) {
+                    its_udp_endpoint->enable_io_uring(
+                            configuration_->get_io_uring_buffers());
+                }
+                its_endpoint = its_udp_endpoint;
             }
 
         } else {
@@ -1250,10 +1389,11 @@ std::shared_ptr<endpoint> routing_manager_impl::find_or_create_server_endpoint(
 }
 
 std::shared_ptr<endpoint> routing_manager_impl::find_local(client_t _client) {
-    std::lock_guard<std::recursive_mutex> its_lock(endpoint_mutex_);
     std::shared_ptr<endpoint> its_endpoint;
-    auto found_endpoint = local_clients_.find(_client);
-    if (found_endpoint != local_clients_.end()) {
+    std::shared_ptr<const local_clients_t> its_clients
+        = std::atomic_load(&local_clients_);
+    auto found_endpoint = its_clients->find(_client);
+    if (found_endpoint != its_clients->end()) {
         its_endpoint = found_endpoint->second;
     }
     return (its_endpoint);
@@ -1270,7 +1410,20 @@ std::shared_ptr<endpoint> routing_manager_impl::create_local(client_t _client) {
     int port = VSOMEIP_INTERNAL_BASE_PORT + _client;
 #endif
 
-    std::shared_ptr<endpoint> its_endpoint = std::make_shared<
+    std::shared_ptr<endpoint> its_endpoint;
+#ifndef WIN32
+    if (configuration_->is_local_shm_enabled(host_->get_name())) {
+        std::stringstream its_ring_name;
+        its_ring_name << VSOMEIP_SHM_NAME << "-" << std::hex
+                << host_->get_client() << "-" << _client;
+        its_endpoint = std::make_shared<local_shm_client_endpoint_impl>(
+                shared_from_this(),
+                boost::asio::local::stream_protocol::endpoint(its_path.str()),
+                io_, configuration_->get_max_message_size_local(),
+                its_ring_name.str());
+    } else
+#endif
+    its_endpoint = std::make_shared<
         local_client_endpoint_impl>(shared_from_this(),
 #ifdef WIN32
         boost::asio::ip::tcp::endpoint(address, port)
@@ -1278,7 +1431,12 @@ std::shared_ptr<endpoint> routing_manager_impl::create_local(client_t _client) {
         boost::asio::local::stream_protocol::endpoint(its_path.str())
 #endif
     , io_, configuration_->get_max_message_size_local());
-    local_clients_[_client] = its_endpoint;
+    std::shared_ptr<local_clients_t> its_clients
+        = std::make_shared<local_clients_t>(*local_clients_);
+    (*its_clients)[_client] = its_endpoint;
+    std::atomic_store(&local_clients_,
+            std::shared_ptr<const local_clients_t>(its_clients));
+    invalidate_delivery_plans();
     its_endpoint->start();
     return (its_endpoint);
 }
@@ -1297,24 +1455,26 @@ void routing_manager_impl::remove_local(client_t _client) {
         std::lock_guard<std::recursive_mutex> its_lock(endpoint_mutex_);
         std::shared_ptr<endpoint> its_endpoint = find_local(_client);
         its_endpoint->stop();
-        local_clients_.erase(_client);
+        std::shared_ptr<local_clients_t> its_clients
+            = std::make_shared<local_clients_t>(*local_clients_);
+        its_clients->erase(_client);
+        std::atomic_store(&local_clients_,
+                std::shared_ptr<const local_clients_t>(its_clients));
+        invalidate_delivery_plans();
     }
     {
         std::lock_guard<std::mutex> its_lock(local_mutex_);
         // Finally remove all services that are implemented by the client.
-        std::set<std::pair<service_t, instance_t>> its_services;
-        for (auto& s : local_services_) {
-            for (auto& i : s.second) {
-                if (i.second == _client)
-                    its_services.insert({ s.first, i.first });
-            }
-        }
-
-        for (auto& si : its_services) {
-            local_services_[si.first].erase(si.second);
-            if (local_services_[si.first].size() == 0)
-                local_services_.erase(si.first);
+        std::shared_ptr<local_services_t> its_services
+            = std::make_shared<local_services_t>(*local_services_);
+        for (auto s = its_services->begin(); s != its_services->end();) {
+            if (s->second == _client)
+                s = its_services->erase(s);
+            else
+                ++s;
         }
+        std::atomic_store(&local_services_,
+                std::shared_ptr<const local_services_t>(its_services));
     }
 }
 
@@ -1329,14 +1489,13 @@ std::shared_ptr<endpoint> routing_manager_impl::find_local(service_t _service,
 
 client_t routing_manager_impl::find_local_client(service_t _service,
         instance_t _instance) {
-    std::lock_guard<std::mutex> its_lock(local_mutex_);
     client_t its_client(0);
-    auto found_service = local_services_.find(_service);
-    if (found_service != local_services_.end()) {
-        auto found_instance = found_service->second.find(_instance);
-        if (found_instance != found_service->second.end()) {
-            its_client = found_instance->second;
-        }
+    std::shared_ptr<const local_services_t> its_services
+        = std::atomic_load(&local_services_);
+    auto found_service = its_services->find(
+            utility::get_key(_service, _instance));
+    if (found_service != its_services->end()) {
+        its_client = found_service->second;
     }
     return (its_client);
 }
@@ -1344,15 +1503,11 @@ client_t routing_manager_impl::find_local_client(service_t _service,
 std::set<client_t> routing_manager_impl::find_local_clients(service_t _service,
         instance_t _instance, eventgroup_t _eventgroup) {
     std::set<client_t> its_clients;
-    auto found_service = eventgroup_clients_.find(_service);
-    if (found_service != eventgroup_clients_.end()) {
-        auto found_instance = found_service->second.find(_instance);
-        if (found_instance != found_service->second.end()) {
-            auto found_eventgroup = found_instance->second.find(_eventgroup);
-            if (found_eventgroup != found_instance->second.end()) {
-                its_clients = found_eventgroup->second;
-            }
-        }
+    std::lock_guard<std::mutex> its_lock(eventgroups_mutex_);
+    auto found_eventgroup = eventgroup_clients_.find(
+            utility::get_key(_service, _instance, _eventgroup));
+    if (found_eventgroup != eventgroup_clients_.end()) {
+        its_clients = found_eventgroup->second;
     }
     return (its_clients);
 }
@@ -1360,8 +1515,10 @@ std::set<client_t> routing_manager_impl::find_local_clients(service_t _service,
 instance_t routing_manager_impl::find_instance(service_t _service,
         endpoint * _endpoint) {
     instance_t its_instance(0xFFFF);
-    auto found_service = service_instances_.find(_service);
-    if (found_service != service_instances_.end()) {
+    std::shared_ptr<const service_instances_t> its_instances
+        = std::atomic_load(&service_instances_);
+    auto found_service = its_instances->find(_service);
+    if (found_service != its_instances->end()) {
         auto found_endpoint = found_service->second.find(_endpoint);
         if (found_endpoint != found_service->second.end()) {
             its_instance = found_endpoint->second;
@@ -1370,6 +1527,53 @@ instance_t routing_manager_impl::find_instance(service_t _service,
     return (its_instance);
 }
 
+void routing_manager_impl::add_service_instance(service_t _service,
+        endpoint *_endpoint, instance_t _instance) {
+    std::lock_guard<std::recursive_mutex> its_lock(endpoint_mutex_);
+    std::shared_ptr<service_instances_t> its_instances
+        = std::make_shared<service_instances_t>(*service_instances_);
+    (*its_instances)[_service][_endpoint] = _instance;
+    std::atomic_store(&service_instances_,
+            std::shared_ptr<const service_instances_t>(its_instances));
+}
+
+void routing_manager_impl::remove_service_instance(service_t _service,
+        endpoint *_endpoint) {
+    std::lock_guard<std::recursive_mutex> its_lock(endpoint_mutex_);
+    std::shared_ptr<service_instances_t> its_instances
+        = std::make_shared<service_instances_t>(*service_instances_);
+    auto found_service = its_instances->find(_service);
+    if (found_service != its_instances->end()) {
+        found_service->second.erase(_endpoint);
+        if (found_service->second.empty()) {
+            its_instances->erase(found_service);
+        }
+    }
+    std::atomic_store(&service_instances_,
+            std::shared_ptr<const service_instances_t>(its_instances));
+}
+
+bool routing_manager_impl::is_io_thread() const {
+    return (std::this_thread::get_id() == io_thread_.load());
+}
+
+bool routing_manager_impl::is_specific_endpoint_client(client_t _client) const {
+    std::lock_guard<std::recursive_mutex> its_lock(endpoint_mutex_);
+    return (specific_endpoint_clients.find(_client)
+            != specific_endpoint_clients.end());
+}
+
+std::shared_ptr<endpoint_definition> routing_manager_impl::find_remote_subscriber(
+        client_t _client) {
+    std::shared_ptr<endpoint_definition> its_subscriber;
+    std::lock_guard<std::mutex> its_lock(remote_subscribers_mutex_);
+    auto found_subscriber = remote_subscriber_map_.find(_client);
+    if (found_subscriber != remote_subscriber_map_.end()) {
+        its_subscriber = found_subscriber->second;
+    }
+    return (its_subscriber);
+}
+
 std::shared_ptr<endpoint> routing_manager_impl::create_remote_client(
         service_t _service, instance_t _instance, bool _reliable, client_t _client) {
     std::shared_ptr<endpoint> its_endpoint;
@@ -1390,8 +1594,15 @@ std::shared_ptr<endpoint> routing_manager_impl::create_remote_client(
         }
     }
     if (its_endpoint) {
-        service_instances_[_service][its_endpoint.get()] = _instance;
-        remote_services_[_service][_instance][_client][_reliable] = its_endpoint;
+        if (!_reliable)
+            set_tp_policy(its_endpoint, _service, _instance);
+        add_service_instance(_service, its_endpoint.get(), _instance);
+        std::shared_ptr<remote_services_t> its_remote_services
+            = std::make_shared<remote_services_t>(*remote_services_);
+        (*its_remote_services)[utility::get_key(_service, _instance)]
+                              [_client][_reliable] = its_endpoint;
+        std::atomic_store(&remote_services_,
+                std::shared_ptr<const remote_services_t>(its_remote_services));
         if (_client == VSOMEIP_ROUTING_CLIENT) {
             client_endpoints_by_ip_[its_endpoint_def->get_address()]
                                    [its_endpoint_def->get_port()]
@@ -1406,20 +1617,31 @@ std::shared_ptr<endpoint> routing_manager_impl::create_remote_client(
     return its_endpoint;
 }
 
+void routing_manager_impl::set_tp_policy(std::shared_ptr<endpoint> _endpoint,
+        service_t _service, instance_t _instance) {
+    uint32_t its_max_message_size
+        = configuration_->get_max_tp_message_size(_service, _instance);
+    if (its_max_message_size > 0) {
+        _endpoint->set_tp_policy(_service,
+                configuration_->get_max_tp_segment_length(_service, _instance),
+                its_max_message_size,
+                configuration_->get_tp_timeout(_service, _instance));
+    }
+}
 
 std::shared_ptr<endpoint> routing_manager_impl::find_remote_client(
         service_t _service, instance_t _instance, bool _reliable, client_t _client) {
     std::shared_ptr<endpoint> its_endpoint;
-    auto found_service = remote_services_.find(_service);
-    if (found_service != remote_services_.end()) {
-        auto found_instance = found_service->second.find(_instance);
-        if (found_instance != found_service->second.end()) {
-            auto found_client = found_instance->second.find(_client);
-            if (found_client != found_instance->second.end()) {
-                auto found_reliability = found_client->second.find(_reliable);
-                if (found_reliability != found_client->second.end()) {
-                    its_endpoint = found_reliability->second;
-                }
+    std::shared_ptr<const remote_services_t> its_remote_services
+        = std::atomic_load(&remote_services_);
+    auto found_instance = its_remote_services->find(
+            utility::get_key(_service, _instance));
+    if (found_instance != its_remote_services->end()) {
+        auto found_client = found_instance->second.find(_client);
+        if (found_client != found_instance->second.end()) {
+            auto found_reliability = found_client->second.find(_reliable);
+            if (found_reliability != found_client->second.end()) {
+                its_endpoint = found_reliability->second;
             }
         }
     }
@@ -1449,9 +1671,16 @@ std::shared_ptr<endpoint> routing_manager_impl::find_remote_client(
                             its_endpoint = found_reliable2->second;
                             // store the endpoint under this service/instance id
                             // as well - needed for later cleanup
-                            remote_services_[_service][_instance][_client][_reliable] =
-                                    its_endpoint;
-                            service_instances_[_service][its_endpoint.get()] = _instance;
+                            std::shared_ptr<remote_services_t> its_services
+                                = std::make_shared<remote_services_t>(
+                                        *its_remote_services);
+                            (*its_services)[utility::get_key(_service, _instance)]
+                                           [_client][_reliable] = its_endpoint;
+                            std::atomic_store(&remote_services_,
+                                    std::shared_ptr<const remote_services_t>(
+                                            its_services));
+                            add_service_instance(_service, its_endpoint.get(),
+                                    _instance);
                         }
                     }
                 }
@@ -1464,15 +1693,11 @@ std::shared_ptr<endpoint> routing_manager_impl::find_remote_client(
 std::shared_ptr<event> routing_manager_impl::find_event(service_t _service,
         instance_t _instance, event_t _event) const {
     std::shared_ptr<event> its_event;
-    auto find_service = events_.find(_service);
-    if (find_service != events_.end()) {
-        auto find_instance = find_service->second.find(_instance);
-        if (find_instance != find_service->second.end()) {
-            auto find_event = find_instance->second.find(_event);
-            if (find_event != find_instance->second.end()) {
-                its_event = find_event->second;
-            }
-        }
+    std::shared_ptr<const events_t> its_events = std::atomic_load(&events_);
+    auto find_event = its_events->find(
+            utility::get_key(_service, _instance, _event));
+    if (find_event != its_events->end()) {
+        its_event = find_event->second;
     }
     return (its_event);
 }
@@ -1480,8 +1705,10 @@ std::shared_ptr<event> routing_manager_impl::find_event(service_t _service,
 std::set<std::shared_ptr<event> > routing_manager_impl::find_events(
         service_t _service, instance_t _instance, eventgroup_t _eventgroup) {
     std::set<std::shared_ptr<event> > its_events;
-    auto found_service = eventgroups_.find(_service);
-    if (found_service != eventgroups_.end()) {
+    std::shared_ptr<const eventgroups_t> its_eventgroups
+        = std::atomic_load(&eventgroups_);
+    auto found_service = its_eventgroups->find(_service);
+    if (found_service != its_eventgroups->end()) {
         auto found_instance = found_service->second.find(_instance);
         if (found_instance != found_service->second.end()) {
             auto found_eventgroup = found_instance->second.find(_eventgroup);
@@ -1496,15 +1723,9 @@ std::set<std::shared_ptr<event> > routing_manager_impl::find_events(
 
 bool routing_manager_impl::is_field(service_t _service, instance_t _instance,
         event_t _event) const {
-    auto find_service = events_.find(_service);
-    if (find_service != events_.end()) {
-        auto find_instance = find_service->second.find(_instance);
-        if (find_instance != find_service->second.end()) {
-            auto find_event = find_instance->second.find(_event);
-            if (find_event != find_instance->second.end())
-                return find_event->second->is_field();
-        }
-    }
+    std::shared_ptr<event> its_event = find_event(_service, _instance, _event);
+    if (its_event)
+        return its_event->is_field();
     return false;
 }
 
@@ -1533,15 +1754,18 @@ void routing_manager_impl::add_routing_info(
         {
             std::lock_guard<std::mutex> its_lock(services_mutex_);
             services_[_service][_instance] = its_info;
+            publish_services();
         }
     } else {
         its_info->set_ttl(_ttl);
     }
+    update_expiration(_service, _instance, _ttl);
 
     // Check whether remote services are unchanged
     bool is_reliable_known(false);
     bool is_unreliable_known(false);
 
+    std::unique_lock<std::recursive_mutex> its_lock(endpoint_mutex_);
     auto found_service = remote_service_info_.find(_service);
     if (found_service != remote_service_info_.end()) {
         auto found_instance = found_service->second.find(_instance);
@@ -1589,6 +1813,7 @@ void routing_manager_impl::add_routing_info(
         remote_service_info_[_service][_instance][false] = endpoint_def;
         is_added = !is_reliable_known;
     }
+    its_lock.unlock();
 
     if (is_added) {
         host_->on_availability(_service, _instance, true);
@@ -1596,6 +1821,17 @@ void routing_manager_impl::add_routing_info(
     }
 }
 
+bool routing_manager_impl::refresh_routing_info(
+        service_t _service, instance_t _instance, ttl_t _ttl) {
+    std::shared_ptr<serviceinfo> its_info(find_service(_service, _instance));
+    if (!its_info)
+        return false;
+
+    its_info->set_ttl(_ttl);
+    update_expiration(_service, _instance, _ttl);
+    return true;
+}
+
 void routing_manager_impl::del_routing_info(service_t _service, instance_t _instance,
         bool _has_reliable, bool _has_unreliable) {
 
@@ -1603,8 +1839,10 @@ void routing_manager_impl::del_routing_info(service_t _service, instance_t _inst
     stub_->on_stop_offer_service(VSOMEIP_ROUTING_CLIENT, _service, _instance);
 
     // Implicit unsubscribe
-    auto found_service = eventgroups_.find(_service);
-    if (found_service != eventgroups_.end()) {
+    std::shared_ptr<const eventgroups_t> its_eventgroups
+        = std::atomic_load(&eventgroups_);
+    auto found_service = its_eventgroups->find(_service);
+    if (found_service != its_eventgroups->end()) {
         auto found_instance = found_service->second.find(_instance);
         if (found_instance != found_service->second.end()) {
             for (auto &its_eventgroup : found_instance->second) {
@@ -1624,43 +1862,67 @@ void routing_manager_impl::del_routing_info(service_t _service, instance_t _inst
         clear_service_info(_service, _instance, true);
     if (_has_unreliable)
         clear_service_info(_service, _instance, false);
+
+    invalidate_delivery_plans(_service, _instance);
 }
 
-ttl_t routing_manager_impl::update_routing_info(ttl_t _elapsed) {
-    ttl_t its_smallest_ttl(DEFAULT_TTL);
-    std::map<service_t,
-        std::map<instance_t,
-            std::pair<bool, bool> > > its_expired_offers;
+void routing_manager_impl::update_expiration(service_t _service,
+        instance_t _instance, ttl_t _ttl) {
+    std::lock_guard<std::mutex> its_lock(ttl_mutex_);
+    std::uint32_t its_key = utility::get_key(_service, _instance);
+    ttl_wheel_.cancel(its_key);
+    if (_ttl < DEFAULT_TTL) { // do not expire "forever"
+        ttl_wheel_.schedule(its_key, std::chrono::seconds(_ttl));
+        start_ttl_timer();
+    }
+}
 
-    for (auto &s : services_) {
-        for (auto &i : s.second) {
-            ttl_t its_ttl = i.second->get_ttl();
-            if (its_ttl < DEFAULT_TTL) { // do not touch "forever"
-                if (its_ttl < _elapsed || its_ttl == 0) {
-                    i.second->set_ttl(0);
-                    if (discovery_)
-                        discovery_->unsubscribe_all(s.first, i.first);
-                    its_expired_offers[s.first][i.first] = {
-                            i.second->get_endpoint(true) != nullptr,
-                            i.second->get_endpoint(false) != nullptr
-                    };
-                } else {
-                    ttl_t its_new_ttl(its_ttl - _elapsed);
-                    i.second->set_ttl(its_new_ttl);
-                    if (its_smallest_ttl > its_new_ttl)
-                        its_smallest_ttl = its_new_ttl;
-                }
-            }
-        }
+void routing_manager_impl::start_ttl_timer() {
+    if (!is_ttl_timer_running_) {
+        is_ttl_timer_running_ = true;
+        ttl_timer_.expires_from_now(ttl_wheel_.get_tick());
+        ttl_timer_.async_wait(
+                std::bind(&routing_manager_impl::expire_ttl,
+                        shared_from_this(), std::placeholders::_1));
     }
+}
 
-    for (auto &s : its_expired_offers) {
-        for (auto &i : s.second) {
-            del_routing_info(s.first, i.first, i.second.first, i.second.second);
+void routing_manager_impl::expire_ttl(const boost::system::error_code &_error) {
+    std::vector<std::uint32_t> its_expired;
+    {
+        std::lock_guard<std::mutex> its_lock(ttl_mutex_);
+        if (_error) {
+            is_ttl_timer_running_ = false;
+            return;
+        }
+
+        ttl_wheel_.advance(its_expired);
+        if (ttl_wheel_.empty()) {
+            is_ttl_timer_running_ = false;
+        } else {
+            // Continue from the previous expiry to not accumulate any drift
+            ttl_timer_.expires_at(
+                    ttl_timer_.expires_at() + ttl_wheel_.get_tick());
+            ttl_timer_.async_wait(
+                    std::bind(&routing_manager_impl::expire_ttl,
+                            shared_from_this(), std::placeholders::_1));
         }
     }
 
-    return its_smallest_ttl;
+    for (auto its_key : its_expired) {
+        service_t its_service = service_t(its_key >> 16);
+        instance_t its_instance = instance_t(its_key & 0xFFFF);
+        std::shared_ptr<serviceinfo> its_info
+            = find_service(its_service, its_instance);
+        if (its_info && its_info->get_ttl() < DEFAULT_TTL) {
+            its_info->set_ttl(0);
+            if (discovery_)
+                discovery_->unsubscribe_all(its_service, its_instance);
+            del_routing_info(its_service, its_instance,
+                    its_info->get_endpoint(true) != nullptr,
+                    its_info->get_endpoint(false) != nullptr);
+        }
+    }
 }
 
 void routing_manager_impl::expire_services(const boost::asio::ip::address &_address) {
@@ -1668,32 +1930,34 @@ void routing_manager_impl::expire_services(const boost::asio::ip::address &_addr
         std::map<instance_t,
             std::pair<bool, bool> > > its_expired_offers;
 
-    for (auto &s : services_) {
-        for (auto &i : s.second) {
-            bool is_gone(false);
-            boost::asio::ip::address its_address;
-            std::shared_ptr<endpoint> its_endpoint = i.second->get_endpoint(true);
+    std::shared_ptr<const service_index_t> its_index
+        = std::atomic_load(&service_index_);
+    for (auto &i : *its_index) {
+        service_t its_service = service_t(i.first >> 16);
+        instance_t its_instance = instance_t(i.first & 0xFFFF);
+        bool is_gone(false);
+        boost::asio::ip::address its_address;
+        std::shared_ptr<endpoint> its_endpoint = i.second->get_endpoint(true);
+        if (its_endpoint) {
+            if (its_endpoint->get_remote_address(its_address)) {
+                is_gone = (its_address == _address);
+            }
+        } else {
+            its_endpoint = i.second->get_endpoint(false);
             if (its_endpoint) {
                 if (its_endpoint->get_remote_address(its_address)) {
                     is_gone = (its_address == _address);
                 }
-            } else {
-                its_endpoint = i.second->get_endpoint(false);
-                if (its_endpoint) {
-                    if (its_endpoint->get_remote_address(its_address)) {
-                        is_gone = (its_address == _address);
-                    }
-                }
             }
+        }
 
-            if (is_gone) {
-                if (discovery_)
-                    discovery_->unsubscribe_all(s.first, i.first);
-                its_expired_offers[s.first][i.first] = {
-                        i.second->get_endpoint(true) != nullptr,
-                        i.second->get_endpoint(false) != nullptr
-                };
-            }
+        if (is_gone) {
+            if (discovery_)
+                discovery_->unsubscribe_all(its_service, its_instance);
+            its_expired_offers[its_service][its_instance] = {
+                    i.second->get_endpoint(true) != nullptr,
+                    i.second->get_endpoint(false) != nullptr
+            };
         }
     }
 
@@ -1705,7 +1969,9 @@ void routing_manager_impl::expire_services(const boost::asio::ip::address &_addr
 }
 
 void routing_manager_impl::expire_subscriptions(const boost::asio::ip::address &_address) {
-    for (auto &its_service : eventgroups_) {
+    std::shared_ptr<const eventgroups_t> its_eventgroups
+        = std::atomic_load(&eventgroups_);
+    for (auto &its_service : *its_eventgroups) {
         for (auto &its_instance : its_service.second) {
             for (auto &its_eventgroup : its_instance.second) {
                 std::set<std::shared_ptr<endpoint_definition>> its_invalid_targets;
@@ -1717,6 +1983,10 @@ void routing_manager_impl::expire_subscriptions(const boost::asio::ip::address &
                 for (auto &its_target : its_invalid_targets) {
                     its_eventgroup.second->remove_target(its_target);
                 }
+                if (!its_invalid_targets.empty()) {
+                    invalidate_delivery_plans(its_service.first,
+                            its_instance.first);
+                }
             }
         }
     }
@@ -1792,9 +2062,13 @@ void routing_manager_impl::on_subscribe(
 
         send_subscribe(client, _service, _instance, _eventgroup, its_eventgroup->get_major());
 
-        remote_subscriber_map_[client] = _target;
+        {
+            std::lock_guard<std::mutex> its_lock(remote_subscribers_mutex_);
+            remote_subscriber_map_[client] = _target;
+        }
 
         if (its_eventgroup->add_target(_target)) { // unicast or multicast
+            invalidate_delivery_plans(_service, _instance);
             for (auto its_event : its_eventgroup->get_events()) {
                 if (its_event->is_field()) {
                     its_event->notify_one(_subscriber); // unicast
@@ -1836,8 +2110,10 @@ void routing_manager_impl::on_unsubscribe(service_t _service,
                       << client << (_target->is_reliable() ? " reliable" : " unreliable");;
 
         its_eventgroup->remove_target(_target);
+        invalidate_delivery_plans(_service, _instance);
 
-        if (remote_subscriber_map_.find(client) != remote_subscriber_map_.end()) {
+        {
+            std::lock_guard<std::mutex> its_lock(remote_subscribers_mutex_);
             remote_subscriber_map_.erase(client);
         }
         host_->on_subscription(_service, _instance, _eventgroup, client, false);
@@ -1850,7 +2126,7 @@ void routing_manager_impl::on_unsubscribe(service_t _service,
 void routing_manager_impl::on_subscribe_ack(service_t _service,
         instance_t _instance, const boost::asio::ip::address &_address,
         uint16_t _port) {
-
+    std::lock_guard<std::recursive_mutex> its_lock(endpoint_mutex_);
     if (multicast_info.find(_service) != multicast_info.end()) {
         if (multicast_info[_service].find(_instance) != multicast_info[_service].end()) {
             auto endpoint_def = multicast_info[_service][_instance];
@@ -1876,7 +2152,7 @@ void routing_manager_impl::on_subscribe_ack(service_t _service,
     std::shared_ptr<endpoint> its_endpoint
         = find_or_create_server_endpoint(_port, false, is_someip);
     if (its_endpoint) {
-        service_instances_[_service][its_endpoint.get()] = _instance;
+        add_service_instance(_service, its_endpoint.get(), _instance);
         its_endpoint->join(_address.to_string());
     } else {
         VSOMEIP_ERROR<<"Could not find/create multicast endpoint!";
@@ -1938,49 +2214,140 @@ void routing_manager_impl::send_unsubscribe(client_t _client, service_t _service
 bool routing_manager_impl::insert_subscription(
         service_t _service, instance_t _instance, eventgroup_t _eventgroup,
         client_t _client) {
+    {
+        std::lock_guard<std::mutex> its_lock(eventgroups_mutex_);
+        if (!eventgroup_clients_[utility::get_key(_service, _instance, _eventgroup)]
+                .insert(_client).second)
+            return false;
+    }
 
-    auto found_service = eventgroup_clients_.find(_service);
-    if (found_service != eventgroup_clients_.end()) {
-        auto found_instance = found_service->second.find(_instance);
-        if (found_instance != found_service->second.end()) {
-            auto found_eventgroup = found_instance->second.find(_eventgroup);
-            if (found_eventgroup != found_instance->second.end()) {
-                if (found_eventgroup->second.find(_client)
-                        != found_eventgroup->second.end())
-                    return false;
+    invalidate_delivery_plans(_service, _instance);
+    return true;
+}
+
+std::shared_ptr<delivery_plan> routing_manager_impl::get_delivery_plan(
+        const std::shared_ptr<event> &_event) {
+    std::uint32_t its_generation = get_plan_generation(
+            _event->get_service(), _event->get_instance());
+    std::shared_ptr<delivery_plan> its_plan = _event->get_delivery_plan();
+    if (!its_plan || its_plan->generation_ != its_generation) {
+        std::lock_guard<std::mutex> its_lock(plan_mutex_);
+        its_plan = _event->get_delivery_plan();
+        if (!its_plan || its_plan->generation_ != its_generation) {
+            its_plan = create_delivery_plan(_event, its_generation);
+            _event->set_delivery_plan(its_plan);
+        }
+    }
+    return its_plan;
+}
+
+std::shared_ptr<delivery_plan> routing_manager_impl::create_delivery_plan(
+        const std::shared_ptr<event> &_event, std::uint32_t _generation) {
+    service_t its_service = _event->get_service();
+    instance_t its_instance = _event->get_instance();
+
+    std::shared_ptr<delivery_plan> its_plan = std::make_shared<delivery_plan>();
+    its_plan->generation_ = _generation;
+    its_plan->is_host_subscribed_ = false;
+
+    std::set<client_t> its_local_clients;
+    for (auto its_group : _event->get_eventgroups()) {
+        auto its_group_clients = find_local_clients(its_service, its_instance, its_group);
+        its_local_clients.insert(its_group_clients.begin(), its_group_clients.end());
+    }
+
+    for (auto its_local_client : its_local_clients) {
+        if (its_local_client == host_->get_client()) {
+            its_plan->is_host_subscribed_ = true;
+            its_plan->host_target_ = find_local(VSOMEIP_ROUTING_CLIENT);
+        } else {
+            std::shared_ptr<endpoint> its_local_target = find_local(its_local_client);
+            if (its_local_target) {
+                its_plan->local_targets_.push_back(its_local_target);
             }
         }
     }
 
-    eventgroup_clients_[_service][_instance][_eventgroup].insert(_client);
-    return true;
+    // we need both endpoints as clients can subscribe to events via TCP and UDP
+    std::shared_ptr<serviceinfo> its_info = find_service(its_service, its_instance);
+    if (its_info) {
+        its_plan->reliable_endpoint_ = its_info->get_endpoint(true);
+        its_plan->unreliable_endpoint_ = its_info->get_endpoint(false);
+    }
+
+    if (its_plan->reliable_endpoint_ || its_plan->unreliable_endpoint_) {
+        std::set<std::tuple<boost::asio::ip::address, uint16_t, bool> > its_known_targets;
+        for (auto its_group : _event->get_eventgroups()) {
+            auto its_eventgroup = find_eventgroup_info(its_service, its_instance, its_group);
+            if (!its_eventgroup)
+                continue;
+
+            for (auto its_remote : its_eventgroup->get_targets()) {
+                bool is_reliable = (its_remote->is_reliable()
+                        && its_plan->reliable_endpoint_);
+                if (!is_reliable && !its_plan->unreliable_endpoint_)
+                    continue;
+
+                if (!its_known_targets.insert(std::make_tuple(
+                        its_remote->get_address(), its_remote->get_port(),
+                        is_reliable)).second)
+                    continue;
+
+                if (is_reliable) {
+                    its_plan->reliable_targets_.push_back(its_remote);
+                } else {
+                    its_plan->unreliable_targets_.push_back(its_remote);
+                }
+            }
+        }
+    }
+
+    return its_plan;
+}
+
+std::atomic<std::uint32_t> & routing_manager_impl::get_plan_generation(
+        service_t _service, instance_t _instance) {
+    return plan_generations_[utility::get_key(_service, _instance)
+            % VSOMEIP_DELIVERY_PLAN_GENERATIONS];
+}
+
+void routing_manager_impl::invalidate_delivery_plans(service_t _service,
+        instance_t _instance) {
+    get_plan_generation(_service, _instance)++;
+}
+
+// Outdates the plans of all events, e.g. if a local endpoint changed
+void routing_manager_impl::invalidate_delivery_plans() {
+    for (std::size_t i = 0; i < VSOMEIP_DELIVERY_PLAN_GENERATIONS; i++)
+        plan_generations_[i]++;
 }
 
 
 bool routing_manager_impl::deliver_specific_endpoint_message(service_t _service,
-        instance_t _instance, const byte_t *_data, length_t _size, endpoint *_receiver) {
+        instance_t _instance, const byte_t *_data, length_t _size,
+        endpoint *_receiver, bool _reliable) {
     // Try to deliver specific endpoint message (for selective subscribers)
-    auto found_servic = remote_services_.find(_service);
-    if (found_servic != remote_services_.end()) {
-        auto found_instance = found_servic->second.find(_instance);
-        if (found_instance != found_servic->second.end()) {
-            for (auto client_entry : found_instance->second) {
-                client_t client = client_entry.first;
-                if (!client) {
-                    continue;
-                }
-                auto found_reliability = client_entry.second.find(_receiver->is_reliable());
-                if (found_reliability != client_entry.second.end()) {
-                    auto found_enpoint = found_reliability->second;
-                    if (found_enpoint.get() == _receiver) {
-                        auto local_endpoint = find_local(client);
-                        if (client != get_client()) {
-                            send_local(local_endpoint, client, _data, _size, _instance, true, _receiver->is_reliable());
-                        } else {
-                            deliver_message(_data, _size, _instance, _receiver->is_reliable());
-                        }
-                        return true;
+    std::shared_ptr<const remote_services_t> its_remote_services
+        = std::atomic_load(&remote_services_);
+    auto found_instance = its_remote_services->find(
+            utility::get_key(_service, _instance));
+    if (found_instance != its_remote_services->end()) {
+        for (auto &client_entry : found_instance->second) {
+            client_t client = client_entry.first;
+            if (!client) {
+                continue;
+            }
+            auto found_reliability = client_entry.second.find(_reliable);
+            if (found_reliability != client_entry.second.end()) {
+                auto found_enpoint = found_reliability->second;
+                if (found_enpoint.get() == _receiver) {
+                    auto local_endpoint = find_local(client);
+                    if (client != get_client()) {
+                        send_local(local_endpoint, client, _data, _size, _instance, true, _reliable);
+                    } else {
+                        deliver_message(_data, _size, _instance, _reliable);
                     }
+                    return true;
                 }
             }
         }
@@ -1994,46 +2361,40 @@ void routing_manager_impl::clear_client_endpoints(service_t _service, instance_t
     std::lock_guard<std::recursive_mutex> its_lock(endpoint_mutex_);
     std::shared_ptr<endpoint> deleted_endpoint;
     // Clear client endpoints for remote services (generic and specific ones)
-    if (remote_services_.find(_service) != remote_services_.end()) {
-        if (remote_services_[_service].find(_instance) != remote_services_[_service].end()) {
-            auto endpoint = remote_services_[_service][_instance][VSOMEIP_ROUTING_CLIENT][_reliable];
+    std::shared_ptr<remote_services_t> its_remote_services
+        = std::make_shared<remote_services_t>(*remote_services_);
+    auto found_instance = its_remote_services->find(
+            utility::get_key(_service, _instance));
+    if (found_instance != its_remote_services->end()) {
+        auto &its_clients = found_instance->second;
+        auto endpoint = its_clients[VSOMEIP_ROUTING_CLIENT][_reliable];
+        if (endpoint) {
+            remove_service_instance(_service, endpoint.get());
+            deleted_endpoint = endpoint;
+        }
+        its_clients[VSOMEIP_ROUTING_CLIENT].erase(_reliable);
+        if (its_clients[VSOMEIP_ROUTING_CLIENT].find(!_reliable)
+                == its_clients[VSOMEIP_ROUTING_CLIENT].end()) {
+            its_clients.erase(VSOMEIP_ROUTING_CLIENT);
+        }
+
+        for (client_t client : specific_endpoint_clients) {
+            auto endpoint = its_clients[client][_reliable];
             if (endpoint) {
-                service_instances_[_service].erase(endpoint.get());
-                deleted_endpoint = endpoint;
-            }
-            remote_services_[_service][_instance][VSOMEIP_ROUTING_CLIENT].erase(_reliable);
-            auto found_endpoint = remote_services_[_service][_instance][VSOMEIP_ROUTING_CLIENT].find(
-                    !_reliable);
-            if (found_endpoint == remote_services_[_service][_instance][VSOMEIP_ROUTING_CLIENT].end()) {
-                remote_services_[_service][_instance].erase(VSOMEIP_ROUTING_CLIENT);
+                remove_service_instance(_service, endpoint.get());
+                endpoint->stop();
             }
-        }
-    }
-    for (client_t client : specific_endpoint_clients) {
-        if (remote_services_.find(_service) != remote_services_.end()) {
-            if (remote_services_[_service].find(_instance) != remote_services_[_service].end()) {
-                auto endpoint = remote_services_[_service][_instance][client][_reliable];
-                if (endpoint) {
-                    service_instances_[_service].erase(endpoint.get());
-                    endpoint->stop();
-                }
-                remote_services_[_service][_instance][client].erase(_reliable);
-                auto found_endpoint = remote_services_[_service][_instance][client].find(!_reliable);
-                if (found_endpoint == remote_services_[_service][_instance][client].end()) {
-                    remote_services_[_service][_instance].erase(client);
-                }
+            its_clients[client].erase(_reliable);
+            if (its_clients[client].find(!_reliable) == its_clients[client].end()) {
+                its_clients.erase(client);
             }
         }
-    }
-    if (remote_services_.find(_service) != remote_services_.end()) {
-        if (remote_services_[_service].find(_instance) != remote_services_[_service].end()) {
-            if (!remote_services_[_service][_instance].size()) {
-                remote_services_[_service].erase(_instance);
-                if (0 >= remote_services_[_service].size()) {
-                    remote_services_.erase(_service);
-                }
-            }
+
+        if (its_clients.empty()) {
+            its_remote_services->erase(found_instance);
         }
+        std::atomic_store(&remote_services_,
+                std::shared_ptr<const remote_services_t>(its_remote_services));
     }
     // Clear remote_service_info_
     if (remote_service_info_.find(_service) != remote_service_info_.end()) {
@@ -2049,9 +2410,6 @@ void routing_manager_impl::clear_client_endpoints(service_t _service, instance_t
         }
     }
 
-    if (1 >= service_instances_[_service].size()) {
-        service_instances_.erase(_service);
-    }
     if(deleted_endpoint) {
         stop_and_delete_client_endpoint(deleted_endpoint);
     }
@@ -2063,18 +2421,17 @@ void routing_manager_impl::stop_and_delete_client_endpoint(
     // reachable through it is online anymore.
     bool delete_endpoint(true);
 
-    for (const auto& service : remote_services_) {
-        for (const auto& instance : service.second) {
-            const auto& client = instance.second.find(VSOMEIP_ROUTING_CLIENT);
-            if(client != instance.second.end()) {
-                for (const auto& reliable : client->second) {
-                    if(reliable.second == _endpoint) {
-                        delete_endpoint = false;
-                        break;
-                    }
+    std::shared_ptr<const remote_services_t> its_remote_services
+        = std::atomic_load(&remote_services_);
+    for (const auto& instance : *its_remote_services) {
+        const auto& client = instance.second.find(VSOMEIP_ROUTING_CLIENT);
+        if(client != instance.second.end()) {
+            for (const auto& reliable : client->second) {
+                if(reliable.second == _endpoint) {
+                    delete_endpoint = false;
+                    break;
                 }
             }
-            if(!delete_endpoint) { break; }
         }
         if(!delete_endpoint) { break; }
     }
@@ -2128,11 +2485,7 @@ void routing_manager_impl::clear_multicast_endpoints(service_t _service, instanc
                 multicast_info.erase(_service);
             }
             // Clear service_instances_ for multicase endpoint
-            if (1 >= service_instances_[_service].size()) {
-                service_instances_.erase(_service);
-            } else {
-                service_instances_[_service].erase(multicast_endpoint.get());
-            }
+            remove_service_instance(_service, multicast_endpoint.get());
         }
     }
 }
@@ -2146,14 +2499,17 @@ void routing_manager_impl::clear_service_info(service_t _service, instance_t _in
     // Clear service_info and service_group
     std::shared_ptr<endpoint> its_empty_endpoint;
     if (!its_info->get_endpoint(!_reliable)) {
+        std::lock_guard<std::mutex> its_lock(services_mutex_);
         if (1 >= services_[_service].size()) {
             services_.erase(_service);
         } else {
             services_[_service].erase(_instance);
         }
+        publish_services();
     } else {
         its_info->set_endpoint(its_empty_endpoint, _reliable);
     }
+    invalidate_delivery_plans(_service, _instance);
 }
 
 return_code_e routing_manager_impl::check_error(const byte_t *_data, length_t _size,
@@ -2175,15 +2531,12 @@ return_code_e routing_manager_impl::check_error(const byte_t *_data, length_t _s
                 return return_code_e::E_UNKNOWN_SERVICE;
             }
             // Check interface version of service/instance
-            auto found_service = services_.find(its_service);
-            if (found_service != services_.end()) {
-                auto found_instance = found_service->second.find(_instance);
-                if (found_instance != found_service->second.end()) {
-                    auto its_info = found_instance->second;
-                    major_version_t its_version = _data[VSOMEIP_INTERFACE_VERSION_POS];
-                    if (its_version != its_info->get_major()) {
-                        return return_code_e::E_WRONG_INTERFACE_VERSION;
-                    }
+            std::shared_ptr<serviceinfo> its_info
+                = find_service(its_service, _instance);
+            if (its_info) {
+                major_version_t its_version = _data[VSOMEIP_INTERFACE_VERSION_POS];
+                if (its_version != its_info->get_major()) {
+                    return return_code_e::E_WRONG_INTERFACE_VERSION;
                 }
             }
             if (_data[VSOMEIP_RETURN_CODE_POS] != static_cast<byte_t> (return_code_e::E_OK)) {
@@ -2201,7 +2554,7 @@ return_code_e routing_manager_impl::check_error(const byte_t *_data, length_t _s
 void routing_manager_impl::send_error(return_code_e _return_code,
         const byte_t *_data, length_t _size,
         instance_t _instance, bool _reliable,
-        endpoint *_receiver) {
+        const std::shared_ptr<endpoint_definition> &_target) {
 
     client_t its_client = 0;
     service_t its_service = 0;
@@ -2235,32 +2588,18 @@ void routing_manager_impl::send_error(return_code_e _return_code,
     error_message->set_service(its_service);
     error_message->set_session(its_session);
 
-    std::lock_guard<std::mutex> its_lock(serialize_mutex_);
-    if (serializer_->serialize(error_message.get())) {
-        if (_receiver) {
-            boost::asio::ip::address adr;
-            uint16_t port;
-            if (_receiver->is_reliable()) {
-                auto remote = static_cast<tcp_server_endpoint_impl*>(_receiver)->get_remote();
-                adr = remote.address();
-                port = remote.port();
-            } else {
-                auto remote = static_cast<udp_server_endpoint_impl*>(_receiver)->get_remote();
-                adr = remote.address();
-                port = remote.port();
-            }
-            auto its_endpoint_def =
-                    std::make_shared<endpoint_definition>(adr, port, _receiver->is_reliable());
-            its_endpoint_def->set_remote_port(_receiver->get_local_port());
-            send_to(its_endpoint_def, serializer_->get_data(), serializer_->get_size());
+    std::shared_ptr<serializer> its_serializer(serializers_.get_serializer());
+    if (its_serializer->serialize(error_message.get())) {
+        if (_target) {
+            send_to(_target, its_serializer->get_data(), its_serializer->get_size());
         } else {
-            send(get_client(), serializer_->get_data(), serializer_->get_size(),
+            send(get_client(), its_serializer->get_data(), its_serializer->get_size(),
                     _instance, true, _reliable);
         }
-        serializer_->reset();
     } else {
         VSOMEIP_ERROR << "Failed to serialize error message.";
     }
+    serializers_.put_serializer(its_serializer);
 }
 
 }
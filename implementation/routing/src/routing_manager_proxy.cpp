@@ -15,6 +15,7 @@
 #include "../../configuration/include/configuration.hpp"
 #include "../../configuration/include/internal.hpp"
 #include "../../endpoints/include/local_client_endpoint_impl.hpp"
+#include "../../endpoints/include/local_shm_client_endpoint_impl.hpp"
 #include "../../endpoints/include/local_server_endpoint_impl.hpp"
 #include "../../logging/include/logger.hpp"
 #include "../../message/include/deserializer.hpp"
@@ -33,8 +34,6 @@ routing_manager_proxy::routing_manager_proxy(routing_manager_host *_host) :
         host_(_host),
         client_(_host->get_client()),
         configuration_(host_->get_configuration()),
-        serializer_(std::make_shared<serializer>()),
-        deserializer_(std::make_shared<deserializer>()),
         sender_(0),
         receiver_(0) {
 }
@@ -51,7 +50,7 @@ client_t routing_manager_proxy::get_client() const {
 }
 
 void routing_manager_proxy::init() {
-    serializer_->create_data(configuration_->get_max_message_size_local());
+    serializers_.set_capacity(configuration_->get_max_message_size_local());
 
     std::stringstream its_sender_path;
     sender_ = create_local(VSOMEIP_ROUTING_CLIENT);
@@ -364,15 +363,15 @@ bool routing_manager_proxy::send(client_t its_client,
         bool _flush) {
     bool is_sent(false);
 
-    std::lock_guard<std::mutex> its_lock(serialize_mutex_);
-    if (serializer_->serialize(_message.get())) {
-        is_sent = send(its_client, serializer_->get_data(),
-                serializer_->get_size(), _message->get_instance(),
+    std::shared_ptr<serializer> its_serializer(serializers_.get_serializer());
+    if (its_serializer->serialize(_message.get())) {
+        is_sent = send(its_client, its_serializer->get_data(),
+                its_serializer->get_size(), _message->get_instance(),
                 _flush, _message->is_reliable());
-        serializer_->reset();
     } else {
         VSOMEIP_ERROR << "Failed to serialize message. Check message size!";
     }
+    serializers_.put_serializer(its_serializer);
     return (is_sent);
 }
 
@@ -546,10 +545,13 @@ void routing_manager_proxy::on_message(const byte_t *_data, length_t _size,
             bool its_reliable;
             std::memcpy(&its_reliable, &_data[_size - sizeof(bool)],
                             sizeof(its_reliable));
-            deserializer_->set_data(&_data[VSOMEIP_COMMAND_PAYLOAD_POS],
+            std::shared_ptr<deserializer> its_deserializer(
+                    serializers_.get_deserializer());
+            its_deserializer->set_data(&_data[VSOMEIP_COMMAND_PAYLOAD_POS],
                     its_length);
             std::shared_ptr<message> its_message(
-                    deserializer_->deserialize_message());
+                    its_deserializer->deserialize_message());
+            serializers_.put_deserializer(its_deserializer);
             if (its_message) {
                 its_message->set_instance(its_instance);
                 its_message->set_reliable(its_reliable);
@@ -557,7 +559,6 @@ void routing_manager_proxy::on_message(const byte_t *_data, length_t _size,
             } else {
                 VSOMEIP_ERROR << "Deserialization of vSomeIP message failed";
             }
-            deserializer_->reset();
         }
             break;
 
@@ -788,7 +789,20 @@ std::shared_ptr<endpoint> routing_manager_proxy::create_local(
             << std::hex << _client << "] at " << its_path.str();
 #endif
 
-    std::shared_ptr<endpoint> its_endpoint = std::make_shared<
+    std::shared_ptr<endpoint> its_endpoint;
+#ifndef WIN32
+    if (configuration_->is_local_shm_enabled(host_->get_name())) {
+        std::stringstream its_ring_name;
+        its_ring_name << VSOMEIP_SHM_NAME << "-" << std::hex
+                << client_ << "-" << _client;
+        its_endpoint = std::make_shared<local_shm_client_endpoint_impl>(
+                shared_from_this(),
+                boost::asio::local::stream_protocol::endpoint(its_path.str()),
+                io_, configuration_->get_max_message_size_local(),
+                its_ring_name.str());
+    } else
+#endif
+    its_endpoint = std::make_shared<
             local_client_endpoint_impl>(shared_from_this(),
 #ifdef WIN32
             boost::asio::ip::tcp::endpoint(address, port),
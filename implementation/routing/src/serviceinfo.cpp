@@ -47,15 +47,15 @@ void serviceinfo::set_ttl(ttl_t _ttl) {
 }
 
 std::shared_ptr<endpoint> serviceinfo::get_endpoint(bool _reliable) const {
-  return (_reliable ? reliable_ : unreliable_);
+  return std::atomic_load(_reliable ? &reliable_ : &unreliable_);
 }
 
 void serviceinfo::set_endpoint(std::shared_ptr<endpoint> _endpoint,
                                bool _reliable) {
   if (_reliable) {
-    reliable_ = _endpoint;
+    std::atomic_store(&reliable_, _endpoint);
   } else {
-    unreliable_ = _endpoint;
+    std::atomic_store(&unreliable_, _endpoint);
   }
 }
 
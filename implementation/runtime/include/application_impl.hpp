@@ -14,6 +14,7 @@
 #include <set>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/asio/signal_set.hpp>
@@ -26,6 +27,7 @@
 namespace vsomeip {
 
 class configuration;
+class dispatcher;
 class logger;
 class routing_manager;
 class routing_manager_stub;
@@ -106,11 +108,16 @@ public:
     VSOMEIP_EXPORT void unregister_subscription_handler(service_t _service,
                 instance_t _instance, eventgroup_t _eventgroup);
 
+    VSOMEIP_EXPORT void register_dispatch_key_handler(
+            dispatch_key_handler_t _handler);
+    VSOMEIP_EXPORT void unregister_dispatch_key_handler();
+
     // routing_manager_host
     VSOMEIP_EXPORT const std::string & get_name() const;
     VSOMEIP_EXPORT client_t get_client() const;
     VSOMEIP_EXPORT std::shared_ptr<configuration> get_configuration() const;
     VSOMEIP_EXPORT boost::asio::io_service & get_io();
+    VSOMEIP_EXPORT boost::asio::io_service & get_endpoint_io();
 
     VSOMEIP_EXPORT void on_state(state_type_e _state);
     VSOMEIP_EXPORT void on_availability(service_t _service, instance_t _instance,
@@ -132,7 +139,6 @@ private:
         }
     }
 
-    void dispatch();
     void wait_for_stop();
 
 private:
@@ -159,6 +165,9 @@ private:
     // Method/Event (=Member) handlers
     std::map<service_t,
             std::map<instance_t, std::map<method_t, message_handler_t> > > members_;
+    // Handlers of already received messages with resolved wildcards
+    std::unordered_map<std::uint64_t, message_handler_t> resolved_members_;
+    std::shared_ptr<dispatch_key_handler_t> dispatch_key_handler_;
     mutable std::mutex members_mutex_;
 
     // Availability handlers
@@ -179,14 +188,14 @@ private:
     // Thread pool for dispatch handlers
     std::size_t num_dispatchers_;
     std::vector<std::thread> dispatchers_;
-    std::atomic_bool is_dispatching_;
-
-    // Handlers
-    mutable std::deque<std::function<void()>> handlers_;
-
-    // Condition to wake up
-    mutable std::mutex dispatch_mutex_;
-    mutable std::condition_variable dispatch_condition_;
+    std::shared_ptr<dispatcher> dispatcher_;
+
+    // Thread pool for network I/O, each thread runs its own I/O service
+    std::size_t num_io_threads_;
+    std::vector<std::shared_ptr<boost::asio::io_service> > endpoint_ios_;
+    std::vector<std::shared_ptr<boost::asio::io_service::work> > endpoint_works_;
+    std::vector<std::thread> io_threads_;
+    std::atomic<std::size_t> next_endpoint_io_;
 
     // Workaround for destruction problem
     std::shared_ptr<logger> logger_;
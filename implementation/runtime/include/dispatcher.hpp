@@ -0,0 +1,119 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef VSOMEIP_DISPATCHER_HPP
+#define VSOMEIP_DISPATCHER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <vsomeip/handler.hpp>
+
+namespace vsomeip {
+
+class message;
+
+// Distributes handler calls to a fixed number of dispatcher threads. Each
+// thread owns a bounded lock-free queue, idle threads steal from the queues
+// of the others. Messages are passed along with their handler instead of
+// being wrapped into an additional closure.
+//
+// In ordered mode tasks are assigned to a queue by their key and stealing
+// is disabled. Thus, tasks with the same key are executed serially in the
+// order they were dispatched, while tasks with different keys may run in
+// parallel.
+class dispatcher {
+public:
+    dispatcher(std::size_t _num_threads, std::size_t _queue_size,
+            bool _is_ordered);
+    ~dispatcher();
+
+    std::size_t get_num_threads() const;
+    bool is_ordered() const;
+
+    void start();
+    void stop();
+
+    // Thread function of the dispatcher thread with the given index
+    void run(std::size_t _index);
+
+    void dispatch(std::uint32_t _key, message_handler_t &&_handler,
+            const std::shared_ptr<message> &_message);
+    void dispatch(std::uint32_t _key, std::function<void()> &&_handler);
+
+private:
+    struct task {
+        message_handler_t message_handler_;
+        std::shared_ptr<message> message_;
+        std::function<void()> handler_;
+    };
+
+    // Bounded multi producer/multi consumer queue (D. Vyukov). Tasks that
+    // do not fit are kept in a locked overflow queue which is consumed
+    // after the lock-free part to keep the order of the tasks.
+    class queue {
+    public:
+        queue(std::size_t _size);
+
+        void push(task &&_task);
+        bool pop(task &_task);
+
+    private:
+        bool try_push(task &_task);
+        bool try_pop(task &_task);
+
+        struct cell {
+            std::atomic<std::size_t> sequence_;
+            task task_;
+        };
+
+        std::vector<cell> cells_;
+        const std::size_t mask_;
+
+        // Keep producer and consumer positions on separate cache lines
+        std::atomic<std::size_t> tail_;
+        char tail_padding_[64 - sizeof(std::atomic<std::size_t>)];
+        std::atomic<std::size_t> head_;
+        char head_padding_[64 - sizeof(std::atomic<std::size_t>)];
+
+        std::atomic<std::size_t> overflow_size_;
+        std::deque<task> overflow_;
+        std::mutex overflow_mutex_;
+    };
+
+    struct waiter {
+        waiter();
+
+        std::atomic<bool> is_sleeping_;
+        std::mutex mutex_;
+        std::condition_variable condition_;
+    };
+
+    std::size_t get_index(std::uint32_t _key);
+
+    void push(std::size_t _index, task &&_task);
+    bool pop(std::size_t _index, task &_task);
+    void wake_up(std::size_t _index);
+
+    const bool is_ordered_;
+
+    std::vector<std::unique_ptr<queue> > queues_;
+    std::vector<std::unique_ptr<waiter> > waiters_;
+    std::atomic<std::size_t> next_;
+    std::atomic<bool> is_dispatching_;
+
+    // Producers only wake up threads if there are sleeping ones
+    std::atomic<std::size_t> num_sleeping_;
+};
+
+} // namespace vsomeip
+
+#endif // VSOMEIP_DISPATCHER_HPP
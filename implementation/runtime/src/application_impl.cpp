@@ -14,9 +14,11 @@
 #include <vsomeip/defines.hpp>
 
 #include "../include/application_impl.hpp"
+#include "../include/dispatcher.hpp"
 #include "../../configuration/include/configuration.hpp"
 #include "../../configuration/include/internal.hpp"
 #include "../../logging/include/logger.hpp"
+#include "../../message/include/message_pool.hpp"
 #include "../../message/include/serializer.hpp"
 #include "../../routing/include/routing_manager_impl.hpp"
 #include "../../routing/include/routing_manager_proxy.hpp"
@@ -31,7 +33,8 @@ application_impl::application_impl(const std::string &_name)
           folder_(VSOMEIP_DEFAULT_CONFIGURATION_FOLDER),
           routing_(0),
           signals_(io_, SIGINT, SIGTERM),
-          num_dispatchers_(0), logger_(logger::get()),
+          num_dispatchers_(0), num_io_threads_(1), next_endpoint_io_(0),
+          logger_(logger::get()),
           stopped_(false) {
 }
 
@@ -172,6 +175,10 @@ bool application_impl::init() {
         }
 
         if (is_routing_manager_host) {
+            num_io_threads_ = its_configuration->get_num_io_threads(name_);
+            for (std::size_t i = 1; i < num_io_threads_; i++)
+                endpoint_ios_.push_back(
+                        std::make_shared<boost::asio::io_service>());
             routing_ = std::make_shared<routing_manager_impl>(this);
         } else {
             routing_ = std::make_shared<routing_manager_proxy>(this);
@@ -180,13 +187,25 @@ bool application_impl::init() {
         routing_->init();
 
         num_dispatchers_ = its_configuration->get_num_dispatchers(name_);
+        if (num_dispatchers_ > 0) {
+            dispatcher_ = std::make_shared<dispatcher>(num_dispatchers_,
+                    VSOMEIP_DEFAULT_DISPATCH_QUEUE_SIZE,
+                    its_configuration->is_ordered_dispatch(name_));
+        }
+
+        if (its_configuration->is_message_pool_enabled()) {
+            message_pool::get().enable(
+                    its_configuration->get_message_pool_size());
+        }
 
         // Smallest allowed session identifier
         session_ = 0x0001;
 
         VSOMEIP_DEBUG<< "Application(" << (name_ != "" ? name_ : "unnamed")
                 << ", " << std::hex << client_ << ") is initialized (uses "
-                << std::dec << num_dispatchers_ << " dispatcher threads).";
+                << std::dec << num_dispatchers_ << " dispatcher threads"
+                << (dispatcher_ && dispatcher_->is_ordered() ? ", ordered" : "")
+                << ").";
 
         is_initialized_ = true;
     }
@@ -226,17 +245,26 @@ void application_impl::start() {
             return;
         }
 
-        is_dispatching_ = true;
-
-        for (size_t i = 0; i < num_dispatchers_; i++)
-            dispatchers_.push_back(
-                    std::thread(std::bind(&application_impl::dispatch, this)));
+        if (dispatcher_) {
+            dispatcher_->start();
+            for (size_t i = 0; i < num_dispatchers_; i++)
+                dispatchers_.push_back(
+                        std::thread(std::bind(&dispatcher::run, dispatcher_, i)));
+        }
 
         if(stop_thread_.joinable()) {
             stop_thread_.join();
         }
         stop_thread_= std::thread(&application_impl::wait_for_stop, this);
 
+        for (auto its_io : endpoint_ios_) {
+            if (its_io->stopped())
+                its_io->reset();
+            endpoint_works_.push_back(
+                    std::make_shared<boost::asio::io_service::work>(*its_io));
+            io_threads_.push_back(std::thread([its_io]() { its_io->run(); }));
+        }
+
         if (routing_)
             routing_->start();
     }
@@ -249,8 +277,8 @@ void application_impl::stop() {
     VSOMEIP_INFO << "Stopping vsomeip application \"" << name_ << "\"";
 #endif
     std::lock_guard<std::mutex> its_lock(start_stop_mutex_);
-    is_dispatching_ = false;
-    dispatch_condition_.notify_all();
+    if (dispatcher_)
+        dispatcher_->stop();
     for (auto &t : dispatchers_) {
         if(t.get_id() == std::this_thread::get_id()) {
             continue;
@@ -262,6 +290,16 @@ void application_impl::stop() {
 
     if (routing_)
         routing_->stop();
+
+    if (message_pool::get().is_enabled()) {
+        std::size_t its_hits = message_pool::get().get_hits();
+        std::size_t its_misses = message_pool::get().get_misses();
+        std::size_t its_total = its_hits + its_misses;
+        VSOMEIP_INFO << "Message pool: " << its_hits << " hits, "
+                << its_misses << " misses ("
+                << (its_total > 0 ? (100 * its_hits) / its_total : 0)
+                << "% hit rate)";
+    }
 #ifndef WIN32
     utility::auto_configuration_exit();
 #endif
@@ -423,10 +461,22 @@ void application_impl::unregister_subscription_handler(service_t _service,
     }
 }
 
+void application_impl::register_dispatch_key_handler(
+        dispatch_key_handler_t _handler) {
+    std::unique_lock<std::mutex> its_lock(members_mutex_);
+    dispatch_key_handler_ = std::make_shared<dispatch_key_handler_t>(_handler);
+}
+
+void application_impl::unregister_dispatch_key_handler() {
+    std::unique_lock<std::mutex> its_lock(members_mutex_);
+    dispatch_key_handler_.reset();
+}
+
 void application_impl::register_message_handler(service_t _service,
         instance_t _instance, method_t _method, message_handler_t _handler) {
     std::unique_lock<std::mutex> its_lock(members_mutex_);
     members_[_service][_instance][_method] = _handler;
+    resolved_members_.clear();
 }
 
 void application_impl::unregister_message_handler(service_t _service,
@@ -442,6 +492,7 @@ void application_impl::unregister_message_handler(service_t _service,
             }
         }
     }
+    resolved_members_.clear();
 }
 
 void application_impl::offer_event(service_t _service, instance_t _instance,
@@ -500,14 +551,19 @@ boost::asio::io_service & application_impl::get_io() {
     return io_;
 }
 
+boost::asio::io_service & application_impl::get_endpoint_io() {
+    std::size_t its_index = (next_endpoint_io_++ % num_io_threads_);
+    if (its_index == 0)
+        return io_;
+    return (*endpoint_ios_[its_index - 1]);
+}
+
 void application_impl::on_state(state_type_e _state) {
     if (handler_) {
-        if (num_dispatchers_ > 0) {
-            std::unique_lock<std::mutex> its_lock(dispatch_mutex_);
-            handlers_.push_back([this, _state]() {
+        if (dispatcher_) {
+            dispatcher_->dispatch(0, [this, _state]() {
                 handler_(_state);
             });
-            dispatch_condition_.notify_one();
         } else {
             handler_(_state);
         }
@@ -551,22 +607,18 @@ void application_impl::on_availability(service_t _service, instance_t _instance,
         }
     }
 
-    if (num_dispatchers_ > 0) {
+    if (dispatcher_) {
         if (has_handler) {
-            std::unique_lock<std::mutex> its_lock(dispatch_mutex_);
-            handlers_.push_back(
+            dispatcher_->dispatch(utility::get_key(_service, _instance),
                     [its_handler, _service, _instance, _is_available]() {
                         its_handler(_service, _instance, _is_available);
                     });
-            dispatch_condition_.notify_one();
         }
         if (has_wildcard_handler) {
-            std::unique_lock < std::mutex > its_lock(dispatch_mutex_);
-            handlers_.push_back(
+            dispatcher_->dispatch(utility::get_key(_service, _instance),
                     [its_wildcard_handler, _service, _instance, _is_available]() {
                         its_wildcard_handler(_service, _instance, _is_available);
                     });
-            dispatch_condition_.notify_one();
         }
     } else {
         if(has_handler) {
@@ -586,40 +638,54 @@ void application_impl::on_message(std::shared_ptr<message> _message) {
     std::map<method_t, message_handler_t>::iterator found_method;
     message_handler_t its_handler;
     bool has_handler(false);
+    std::shared_ptr<dispatch_key_handler_t> its_key_handler;
 
     {
         std::unique_lock<std::mutex> its_lock(members_mutex_);
-
-        auto found_service = members_.find(its_service);
-        if (found_service == members_.end()) {
-            found_service = members_.find(ANY_SERVICE);
-        }
-        if (found_service != members_.end()) {
-            auto found_instance = found_service->second.find(its_instance);
-            if (found_instance == found_service->second.end()) {
-                found_instance = found_service->second.find(ANY_INSTANCE);
+        if (dispatcher_ && dispatcher_->is_ordered())
+            its_key_handler = dispatch_key_handler_;
+
+        std::uint64_t its_key
+            = utility::get_key(its_service, its_instance, its_method);
+        auto found_resolved = resolved_members_.find(its_key);
+        if (found_resolved != resolved_members_.end()) {
+            its_handler = found_resolved->second;
+            has_handler = true;
+        } else {
+            auto found_service = members_.find(its_service);
+            if (found_service == members_.end()) {
+                found_service = members_.find(ANY_SERVICE);
             }
-            if (found_instance != found_service->second.end()) {
-                auto found_method = found_instance->second.find(its_method);
-                if (found_method == found_instance->second.end()) {
-                    found_method = found_instance->second.find(ANY_METHOD);
+            if (found_service != members_.end()) {
+                auto found_instance = found_service->second.find(its_instance);
+                if (found_instance == found_service->second.end()) {
+                    found_instance = found_service->second.find(ANY_INSTANCE);
                 }
+                if (found_instance != found_service->second.end()) {
+                    auto found_method = found_instance->second.find(its_method);
+                    if (found_method == found_instance->second.end()) {
+                        found_method = found_instance->second.find(ANY_METHOD);
+                    }
 
-                if (found_method != found_instance->second.end()) {
-                    its_handler = found_method->second;
-                    has_handler = true;
+                    if (found_method != found_instance->second.end()) {
+                        its_handler = found_method->second;
+                        has_handler = true;
+                        if (resolved_members_.size()
+                                < VSOMEIP_MAX_RESOLVED_HANDLERS) {
+                            resolved_members_[its_key] = its_handler;
+                        }
+                    }
                 }
             }
         }
     }
 
     if (has_handler) {
-        if (num_dispatchers_ > 0) {
-            std::unique_lock<std::mutex> its_lock(dispatch_mutex_);
-            handlers_.push_back([its_handler, _message]() {
-                its_handler(_message);
-            });
-            dispatch_condition_.notify_one();
+        if (dispatcher_) {
+            std::uint32_t its_key = (its_key_handler ?
+                    (*its_key_handler)(_message) :
+                    utility::get_key(its_service, its_instance));
+            dispatcher_->dispatch(its_key, std::move(its_handler), _message);
         } else {
             its_handler(_message);
         }
@@ -641,23 +707,6 @@ void application_impl::service() {
     io_.run();
 }
 
-void application_impl::dispatch() {
-    std::function<void()> handler;
-    while (is_dispatching_) {
-        {
-            std::unique_lock<std::mutex> its_lock(dispatch_mutex_);
-            if (handlers_.empty()) {
-                dispatch_condition_.wait(its_lock);
-                continue;
-            } else {
-                handler = handlers_.front();
-                handlers_.pop_front();
-            }
-        }
-        handler();
-    }
-}
-
 void application_impl::wait_for_stop() {
     std::unique_lock<std::mutex> its_lock(start_stop_mutex_);
     while(!stopped_) {
@@ -670,6 +719,16 @@ void application_impl::wait_for_stop() {
             t.join();
         }
     }
+
+    endpoint_works_.clear();
+    for (auto its_io : endpoint_ios_)
+        its_io->stop();
+    for (auto &t : io_threads_) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+    io_threads_.clear();
     io_.stop();
 }
 
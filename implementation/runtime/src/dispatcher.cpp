@@ -0,0 +1,238 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstdint>
+
+#include <vsomeip/message.hpp>
+
+#include "../include/dispatcher.hpp"
+
+namespace vsomeip {
+
+dispatcher::queue::queue(std::size_t _size)
+    : cells_(_size), mask_(_size - 1),
+      tail_(0), head_(0), overflow_size_(0) {
+    for (std::size_t i = 0; i < cells_.size(); i++)
+        cells_[i].sequence_.store(i, std::memory_order_relaxed);
+}
+
+void dispatcher::queue::push(task &&_task) {
+    if (0 == overflow_size_.load(std::memory_order_acquire)
+            && try_push(_task))
+        return;
+
+    std::lock_guard<std::mutex> its_lock(overflow_mutex_);
+    overflow_.push_back(std::move(_task));
+    overflow_size_++;
+}
+
+bool dispatcher::queue::pop(task &_task) {
+    if (try_pop(_task))
+        return true;
+
+    if (0 < overflow_size_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> its_lock(overflow_mutex_);
+        if (!overflow_.empty()) {
+            _task = std::move(overflow_.front());
+            overflow_.pop_front();
+            overflow_size_--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool dispatcher::queue::try_push(task &_task) {
+    cell *its_cell;
+    std::size_t its_position = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+        its_cell = &cells_[its_position & mask_];
+        std::size_t its_sequence
+            = its_cell->sequence_.load(std::memory_order_acquire);
+        std::intptr_t its_difference
+            = std::intptr_t(its_sequence) - std::intptr_t(its_position);
+        if (its_difference == 0) {
+            if (tail_.compare_exchange_weak(its_position, its_position + 1,
+                    std::memory_order_relaxed))
+                break;
+        } else if (its_difference < 0) {
+            return false; // full
+        } else {
+            its_position = tail_.load(std::memory_order_relaxed);
+        }
+    }
+
+    its_cell->task_ = std::move(_task);
+    its_cell->sequence_.store(its_position + 1, std::memory_order_release);
+    return true;
+}
+
+bool dispatcher::queue::try_pop(task &_task) {
+    cell *its_cell;
+    std::size_t its_position = head_.load(std::memory_order_relaxed);
+    for (;;) {
+        its_cell = &cells_[its_position & mask_];
+        std::size_t its_sequence
+            = its_cell->sequence_.load(std::memory_order_acquire);
+        std::intptr_t its_difference
+            = std::intptr_t(its_sequence) - std::intptr_t(its_position + 1);
+        if (its_difference == 0) {
+            if (head_.compare_exchange_weak(its_position, its_position + 1,
+                    std::memory_order_relaxed))
+                break;
+        } else if (its_difference < 0) {
+            return false; // empty
+        } else {
+            its_position = head_.load(std::memory_order_relaxed);
+        }
+    }
+
+    _task = std::move(its_cell->task_);
+    its_cell->task_ = task();
+    its_cell->sequence_.store(its_position + mask_ + 1,
+            std::memory_order_release);
+    return true;
+}
+
+dispatcher::waiter::waiter()
+    : is_sleeping_(false) {
+}
+
+dispatcher::dispatcher(std::size_t _num_threads, std::size_t _queue_size,
+        bool _is_ordered)
+    : is_ordered_(_is_ordered),
+      next_(0), is_dispatching_(false), num_sleeping_(0) {
+    std::size_t its_queue_size(2);
+    while (its_queue_size < _queue_size)
+        its_queue_size <<= 1;
+
+    if (0 == _num_threads)
+        _num_threads = 1;
+
+    for (std::size_t i = 0; i < _num_threads; i++) {
+        queues_.push_back(std::unique_ptr<queue>(new queue(its_queue_size)));
+        waiters_.push_back(std::unique_ptr<waiter>(new waiter));
+    }
+}
+
+dispatcher::~dispatcher() {
+}
+
+std::size_t dispatcher::get_num_threads() const {
+    return queues_.size();
+}
+
+bool dispatcher::is_ordered() const {
+    return is_ordered_;
+}
+
+void dispatcher::start() {
+    is_dispatching_ = true;
+}
+
+void dispatcher::stop() {
+    is_dispatching_ = false;
+    for (auto &its_waiter : waiters_) {
+        std::lock_guard<std::mutex> its_lock(its_waiter->mutex_);
+        its_waiter->condition_.notify_one();
+    }
+}
+
+void dispatcher::run(std::size_t _index) {
+    waiter &its_waiter = *waiters_[_index];
+    task its_task;
+    while (is_dispatching_) {
+        bool has_task = pop(_index, its_task);
+        if (!has_task) {
+            std::unique_lock<std::mutex> its_lock(its_waiter.mutex_);
+            its_waiter.is_sleeping_ = true;
+            num_sleeping_++;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            has_task = pop(_index, its_task);
+            if (!has_task && is_dispatching_)
+                its_waiter.condition_.wait(its_lock);
+            num_sleeping_--;
+            its_waiter.is_sleeping_ = false;
+        }
+
+        if (has_task) {
+            if (its_task.message_handler_) {
+                its_task.message_handler_(its_task.message_);
+            } else if (its_task.handler_) {
+                its_task.handler_();
+            }
+            its_task = task();
+        }
+    }
+}
+
+void dispatcher::dispatch(std::uint32_t _key, message_handler_t &&_handler,
+        const std::shared_ptr<message> &_message) {
+    task its_task;
+    its_task.message_handler_ = std::move(_handler);
+    its_task.message_ = _message;
+    push(get_index(_key), std::move(its_task));
+}
+
+void dispatcher::dispatch(std::uint32_t _key,
+        std::function<void()> &&_handler) {
+    task its_task;
+    its_task.handler_ = std::move(_handler);
+    push(get_index(_key), std::move(its_task));
+}
+
+std::size_t dispatcher::get_index(std::uint32_t _key) {
+    if (is_ordered_) {
+        std::uint32_t its_hash = _key * 0x9E3779B1;
+        return ((its_hash ^ (its_hash >> 16)) % queues_.size());
+    }
+    return (next_.fetch_add(1, std::memory_order_relaxed) % queues_.size());
+}
+
+void dispatcher::push(std::size_t _index, task &&_task) {
+    queues_[_index]->push(std::move(_task));
+
+    // Pairs with the fence of a dispatcher thread that is going to sleep:
+    // either it finds the task or we see it sleeping.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (0 < num_sleeping_.load(std::memory_order_relaxed)) {
+        if (is_ordered_ || waiters_[_index]->is_sleeping_) {
+            wake_up(_index);
+        } else {
+            // Any sleeping thread will steal the task
+            for (std::size_t i = 1; i < waiters_.size(); i++) {
+                std::size_t its_index = (_index + i) % waiters_.size();
+                if (waiters_[its_index]->is_sleeping_) {
+                    wake_up(its_index);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+bool dispatcher::pop(std::size_t _index, task &_task) {
+    if (queues_[_index]->pop(_task))
+        return true;
+
+    // Steal from the other dispatcher threads
+    if (!is_ordered_) {
+        for (std::size_t i = 1; i < queues_.size(); i++) {
+            if (queues_[(_index + i) % queues_.size()]->pop(_task))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+void dispatcher::wake_up(std::size_t _index) {
+    waiter &its_waiter = *waiters_[_index];
+    std::lock_guard<std::mutex> its_lock(its_waiter.mutex_);
+    its_waiter.condition_.notify_one();
+}
+
+} // namespace vsomeip
@@ -8,6 +8,7 @@
 #include "../include/application_impl.hpp"
 #include "../include/runtime_impl.hpp"
 #include "../../message/include/message_impl.hpp"
+#include "../../message/include/message_pool.hpp"
 #include "../../message/include/payload_impl.hpp"
 
 namespace vsomeip {
@@ -30,7 +31,8 @@ std::shared_ptr<application> runtime_impl::create_application(
 
 std::shared_ptr<message> runtime_impl::create_message(bool _reliable) const {
     std::shared_ptr<message_impl> its_message =
-            std::make_shared<message_impl>();
+            std::allocate_shared<message_impl>(
+                message_pool_allocator<message_impl>());
     its_message->set_protocol_version(VSOMEIP_PROTOCOL_VERSION);
     its_message->set_return_code(return_code_e::E_OK);
     its_message->set_reliable(_reliable);
@@ -40,7 +42,8 @@ std::shared_ptr<message> runtime_impl::create_message(bool _reliable) const {
 
 std::shared_ptr<message> runtime_impl::create_request(bool _reliable) const {
     std::shared_ptr<message_impl> its_request =
-            std::make_shared<message_impl>();
+            std::allocate_shared<message_impl>(
+                message_pool_allocator<message_impl>());
     its_request->set_protocol_version(VSOMEIP_PROTOCOL_VERSION);
     its_request->set_message_type(message_type_e::MT_REQUEST);
     its_request->set_return_code(return_code_e::E_OK);
@@ -52,7 +55,8 @@ std::shared_ptr<message> runtime_impl::create_request(bool _reliable) const {
 std::shared_ptr<message> runtime_impl::create_response(
         const std::shared_ptr<message> &_request) const {
     std::shared_ptr<message_impl> its_response =
-            std::make_shared<message_impl>();
+            std::allocate_shared<message_impl>(
+                message_pool_allocator<message_impl>());
     its_response->set_service(_request->get_service());
     its_response->set_instance(_request->get_instance());
     its_response->set_method(_request->get_method());
@@ -67,8 +71,8 @@ std::shared_ptr<message> runtime_impl::create_response(
 
 std::shared_ptr<message> runtime_impl::create_notification(
         bool _reliable) const {
-    std::shared_ptr<message_impl> its_notification = std::make_shared<
-            message_impl>();
+    std::shared_ptr<message_impl> its_notification = std::allocate_shared<
+            message_impl>(message_pool_allocator<message_impl>());
     its_notification->set_protocol_version(VSOMEIP_PROTOCOL_VERSION);
     its_notification->set_message_type(message_type_e::MT_NOTIFICATION);
     its_notification->set_return_code(return_code_e::E_OK);
@@ -78,17 +82,20 @@ std::shared_ptr<message> runtime_impl::create_notification(
 }
 
 std::shared_ptr<payload> runtime_impl::create_payload() const {
-    return (std::make_shared<payload_impl>());
+    return (std::allocate_shared<payload_impl>(
+            message_pool_allocator<payload_impl>()));
 }
 
 std::shared_ptr<payload> runtime_impl::create_payload(const byte_t *_data,
         uint32_t _size) const {
-    return (std::make_shared<payload_impl>(_data, _size));
+    return (std::allocate_shared<payload_impl>(
+            message_pool_allocator<payload_impl>(), _data, _size));
 }
 
 std::shared_ptr<payload> runtime_impl::create_payload(
         const std::vector<byte_t> &_data) const {
-    return (std::make_shared<payload_impl>(_data));
+    return (std::allocate_shared<payload_impl>(
+            message_pool_allocator<payload_impl>(), _data));
 }
 
 std::shared_ptr<application> runtime_impl::get_application(
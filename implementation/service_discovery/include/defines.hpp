@@ -9,6 +9,13 @@
 #define VSOMEIP_SOMEIP_SD_DATA_SIZE              12
 #define VSOMEIP_SOMEIP_SD_ENTRY_SIZE             16
 #define VSOMEIP_SOMEIP_SD_OPTION_HEADER_SIZE     3
+#define VSOMEIP_SOMEIP_SD_IPV6_OPTION_SIZE       24
+#define VSOMEIP_SOMEIP_SD_FLAGS_POS              16
+#define VSOMEIP_SOMEIP_SD_ENTRIES_LENGTH_POS     20
+#define VSOMEIP_SOMEIP_SD_ENTRIES_POS            24
+
+#define VSOMEIP_REBOOT_FLAG                      0x80
+#define VSOMEIP_UNICAST_FLAG                     0x40
 
 #define VSOMEIP_SD_SERVICE                       0xFFFF
 #define VSOMEIP_SD_INSTANCE                      0x0000
@@ -55,6 +55,9 @@ public:
     const std::vector<std::shared_ptr<option_impl> > & get_options() const;
 
     int16_t get_option_index(const std::shared_ptr<option_impl> &_option) const;
+    // Replaces a new option by an equal option of the message, if any.
+    std::shared_ptr<option_impl> merge_option(
+            const std::shared_ptr<option_impl> &_option);
     uint32_t get_options_length();
 
     std::shared_ptr<payload> get_payload() const;
@@ -0,0 +1,73 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef VSOMEIP_SD_MESSAGE_VIEW_HPP
+#define VSOMEIP_SD_MESSAGE_VIEW_HPP
+
+#include <vector>
+
+#include <vsomeip/enumeration_types.hpp>
+#include <vsomeip/primitive_types.hpp>
+
+#include "enumeration_types.hpp"
+#include "primitive_types.hpp"
+
+namespace vsomeip {
+namespace sd {
+
+// Read-only view of a serialized SD message. Entries and options are read
+// from the receive buffer on access, nothing is copied. The view is only
+// valid as long as the buffer is.
+class message_view {
+public:
+    class entry_view {
+    public:
+        entry_view(const byte_t *_data);
+
+        entry_type_e get_type() const;
+        service_t get_service() const;
+        instance_t get_instance() const;
+        major_version_t get_major_version() const;
+        ttl_t get_ttl() const;
+        minor_version_t get_minor_version() const;
+
+        uint8_t get_option_index(uint8_t _run) const;
+        uint8_t get_num_options(uint8_t _run) const;
+
+    private:
+        const byte_t *data_;
+    };
+
+    message_view(const byte_t *_data, length_t _length);
+
+    bool is_valid() const;
+
+    session_t get_session() const;
+    bool get_reboot_flag() const;
+
+    protocol_version_t get_protocol_version() const;
+    interface_version_t get_interface_version() const;
+    message_type_e get_message_type() const;
+
+    std::size_t get_num_entries() const;
+    entry_view get_entry(std::size_t _index) const;
+
+    // Returns the serialized option including its header
+    bool get_option(uint8_t _index,
+            const byte_t *&_data, std::size_t &_size) const;
+
+private:
+    const byte_t *data_;
+    bool is_valid_;
+
+    std::size_t num_entries_;
+    std::vector<const byte_t *> options_;
+    const byte_t *options_end_;
+};
+
+} // namespace sd
+} // namespace vsomeip
+
+#endif // VSOMEIP_SD_MESSAGE_VIEW_HPP
@@ -0,0 +1,48 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef VSOMEIP_SD_REMOTE_OFFERS_HPP
+#define VSOMEIP_SD_REMOTE_OFFERS_HPP
+
+#include <map>
+#include <vector>
+
+#include <boost/asio/ip/address.hpp>
+
+#include <vsomeip/primitive_types.hpp>
+
+namespace vsomeip {
+namespace sd {
+
+class message_view;
+
+// Version and endpoint options of the last offer per remote service.
+// Offers that repeat them only need to refresh the TTL of the service.
+class remote_offers {
+public:
+    // Returns true if the message only contains offers that repeat the
+    // last offers of the sender.
+    bool is_unchanged(const message_view &_view,
+            const boost::asio::ip::address &_sender) const;
+
+    // Remembers the offers and forgets the stop offers of the message.
+    void update(const message_view &_view,
+            const boost::asio::ip::address &_sender);
+
+    void remove(const boost::asio::ip::address &_sender);
+
+private:
+    static bool get_signature(const message_view &_view, std::size_t _index,
+            std::vector<byte_t> &_signature);
+
+    std::map<boost::asio::ip::address,
+            std::map<service_t,
+                    std::map<instance_t, std::vector<byte_t> > > > offers_;
+};
+
+} // namespace sd
+} // namespace vsomeip
+
+#endif // VSOMEIP_SD_REMOTE_OFFERS_HPP
@@ -40,6 +40,9 @@ public:
     virtual bool send(client_t _client, std::shared_ptr<message> _message,
             bool _flush) = 0;
 
+    virtual bool send(client_t _client, const byte_t *_data, uint32_t _size,
+            instance_t _instance, bool _flush, bool _reliable) = 0;
+
     virtual bool send_to(const std::shared_ptr<endpoint_definition> &_target,
             const byte_t *_data, uint32_t _size) = 0;
 
@@ -50,11 +53,12 @@ public:
             const boost::asio::ip::address &_unreliable_address,
             uint16_t _unreliable_port) = 0;
 
+    virtual bool refresh_routing_info(service_t _service,
+            instance_t _instance, ttl_t _ttl) = 0;
+
     virtual void del_routing_info(service_t _service, instance_t _instance,
             bool _has_reliable, bool _has_unreliable) = 0;
 
-    virtual ttl_t update_routing_info(ttl_t _elapsed) = 0;
-
     virtual void on_subscribe(service_t _service, instance_t _instance,
             eventgroup_t _eventgroup,
             std::shared_ptr<endpoint_definition> _subscriber,
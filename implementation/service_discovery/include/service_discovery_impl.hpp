@@ -6,16 +6,17 @@
 #ifndef VSOMEIP_SERVICE_DISCOVERY_IMPL
 #define VSOMEIP_SERVICE_DISCOVERY_IMPL
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <set>
-
-#include <boost/asio/system_timer.hpp>
+#include <vector>
 
 #include "service_discovery.hpp"
 #include "../../routing/include/types.hpp"
 #include "ip_option_impl.hpp"
+#include "remote_offers.hpp"
 
 namespace vsomeip {
 
@@ -26,6 +27,7 @@ namespace sd {
 
 class entry_impl;
 class eventgroupentry_impl;
+class message_view;
 class option_impl;
 class request;
 class serviceentry_impl;
@@ -94,6 +96,12 @@ private:
             instance_t _instance, eventgroup_t _eventgroup,
             std::shared_ptr<eventgroupinfo> &_info);
 
+    void send_offers();
+
+    bool refresh_offers(const message_view &_view,
+            const boost::asio::ip::address &_sender);
+    bool is_acknowledged(service_t _service, instance_t _instance);
+
     void process_serviceentry(std::shared_ptr<serviceentry_impl> &_entry,
             const std::vector<std::shared_ptr<option_impl> > &_options);
     void process_offerservice_serviceentry(
@@ -114,6 +122,10 @@ private:
     void process_eventgroupentry(std::shared_ptr<eventgroupentry_impl> &_entry,
             const std::vector<std::shared_ptr<option_impl> > &_options);
 
+    std::shared_ptr<message_impl> get_acknowledgement(
+            const boost::asio::ip::address &_address);
+    void send_acknowledgements();
+
     void handle_eventgroup_subscription(service_t _service,
             instance_t _instance, eventgroup_t _eventgroup,
             major_version_t _major, ttl_t _ttl,
@@ -126,12 +138,8 @@ private:
     void serialize_and_send(std::shared_ptr<message_impl> _message,
             const boost::asio::ip::address &_address);
 
-    void start_ttl_timer();
-    ttl_t stop_ttl_timer();
-    void check_ttl(const boost::system::error_code &_error);
     boost::asio::ip::address get_current_remote_address() const;
-    bool check_static_header_fields(
-            const std::shared_ptr<const message> &_message) const;
+    bool check_static_header_fields(const message_view &_view) const;
     void send_eventgroup_subscription_nack(service_t _service,
                                            instance_t _instance,
                                            eventgroup_t _eventgroup,
@@ -170,6 +178,15 @@ private:
 
     std::mutex serialize_mutex_;
 
+    // Serialized offers of the main phase. They are rebuilt after the
+    // offered services changed, otherwise only the session is updated.
+    std::vector<byte_t> offer_cache_;
+    bool is_offer_cache_valid_;
+    std::mutex offer_cache_mutex_;
+
+    // Offers that repeat the last offer of the sender only refresh the TTL
+    remote_offers offers_;
+
     // Sessions
     std::map<boost::asio::ip::address, std::pair<session_t, bool> > sessions_;
     std::map<boost::asio::ip::address, session_t > sessions_receiving_;
@@ -177,12 +194,17 @@ private:
     // Reboots
     std::set<boost::asio::ip::address> reboots_;
 
+    // Subscription (N)ACKs are collected per subscriber while an SD message
+    // is processed. They are sent in as few SD messages as possible before
+    // the new subscribers are registered.
+    std::map<boost::asio::ip::address,
+            std::vector<std::shared_ptr<message_impl> > > acknowledgements_;
+    std::vector<std::function<void()> > subscribers_;
+
     // Runtime
     std::weak_ptr<runtime> runtime_;
 
-    // TTL handling
-    boost::asio::system_timer ttl_timer_;
-    ttl_t smallest_ttl_;
+    // TTL of the offers
     ttl_t ttl_;
 };
 
@@ -25,11 +25,9 @@ bool ip_option_impl::operator ==(const option_impl &_other) const {
     if (type_ != _other.get_type())
         return false;
 
-#ifdef VSOMEIP_TODO
     const ip_option_impl & other =
             dynamic_cast<const ip_option_impl &>(_other);
-#endif
-    return true;
+    return (protocol_ == other.protocol_ && port_ == other.port_);
 }
 
 unsigned short ip_option_impl::get_port() const {
@@ -24,6 +24,15 @@ ipv4_option_impl::ipv4_option_impl(bool _is_multicast) :
 ipv4_option_impl::~ipv4_option_impl() {
 }
 
+bool ipv4_option_impl::operator ==(const option_impl &_other) const {
+    if (!ip_option_impl::operator ==(_other))
+        return false;
+
+    const ipv4_option_impl & other =
+            dynamic_cast<const ipv4_option_impl &>(_other);
+    return (address_ == other.address_);
+}
+
 const ipv4_address_t & ipv4_option_impl::get_address() const {
     return address_;
 }
@@ -3,6 +3,7 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
 #include <typeinfo>
 
 #include <vsomeip/constants.hpp>
@@ -48,8 +49,6 @@ length_t message_impl::get_length() const {
     return current_length;
 }
 
-#define VSOMEIP_REBOOT_FLAG 0x80
-
 bool message_impl::get_reboot_flag() const {
     return ((flags_ & VSOMEIP_REBOOT_FLAG) != 0);
 }
@@ -61,8 +60,6 @@ void message_impl::set_reboot_flag(bool _is_set) {
         flags_ &= flags_t(~VSOMEIP_REBOOT_FLAG);
 }
 
-#define VSOMEIP_UNICAST_FLAG 0x40
-
 bool message_impl::get_unicast_flag() const {
     return ((flags_ & VSOMEIP_UNICAST_FLAG) != 0);
 }
@@ -165,6 +162,18 @@ int16_t message_impl::get_option_index(
     return -1;
 }
 
+std::shared_ptr<option_impl> message_impl::merge_option(
+        const std::shared_ptr<option_impl> &_option) {
+    for (auto its_option : options_) {
+        if (its_option != _option && *its_option == *_option) {
+            options_.erase(
+                    std::find(options_.begin(), options_.end(), _option));
+            return its_option;
+        }
+    }
+    return _option;
+}
+
 uint32_t message_impl::get_options_length() {
     return options_length_;
 }
@@ -0,0 +1,154 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <vsomeip/defines.hpp>
+
+#include "../include/defines.hpp"
+#include "../include/message_view.hpp"
+#include "../../utility/include/byteorder.hpp"
+
+namespace vsomeip {
+namespace sd {
+
+message_view::entry_view::entry_view(const byte_t *_data)
+    : data_(_data) {
+}
+
+entry_type_e message_view::entry_view::get_type() const {
+    return static_cast<entry_type_e>(data_[0]);
+}
+
+service_t message_view::entry_view::get_service() const {
+    return VSOMEIP_BYTES_TO_WORD(data_[4], data_[5]);
+}
+
+instance_t message_view::entry_view::get_instance() const {
+    return VSOMEIP_BYTES_TO_WORD(data_[6], data_[7]);
+}
+
+major_version_t message_view::entry_view::get_major_version() const {
+    return data_[8];
+}
+
+ttl_t message_view::entry_view::get_ttl() const {
+    return VSOMEIP_BYTES_TO_LONG(0, data_[9], data_[10], data_[11]);
+}
+
+minor_version_t message_view::entry_view::get_minor_version() const {
+    return VSOMEIP_BYTES_TO_LONG(data_[12], data_[13], data_[14], data_[15]);
+}
+
+uint8_t message_view::entry_view::get_option_index(uint8_t _run) const {
+    return (_run == 1 ? data_[1] : data_[2]);
+}
+
+uint8_t message_view::entry_view::get_num_options(uint8_t _run) const {
+    return uint8_t(_run == 1 ? data_[3] >> 4 : data_[3] & 0xF);
+}
+
+message_view::message_view(const byte_t *_data, length_t _length)
+    : data_(_data),
+      is_valid_(false),
+      num_entries_(0),
+      options_end_(_data + _length) {
+
+    if (_length < VSOMEIP_SOMEIP_SD_ENTRIES_POS)
+        return;
+
+    uint32_t its_entries_length = VSOMEIP_BYTES_TO_LONG(
+            _data[VSOMEIP_SOMEIP_SD_ENTRIES_LENGTH_POS],
+            _data[VSOMEIP_SOMEIP_SD_ENTRIES_LENGTH_POS + 1],
+            _data[VSOMEIP_SOMEIP_SD_ENTRIES_LENGTH_POS + 2],
+            _data[VSOMEIP_SOMEIP_SD_ENTRIES_LENGTH_POS + 3]);
+    if (its_entries_length % VSOMEIP_SOMEIP_SD_ENTRY_SIZE != 0
+            || its_entries_length > _length - VSOMEIP_SOMEIP_SD_ENTRIES_POS)
+        return;
+
+    num_entries_ = its_entries_length / VSOMEIP_SOMEIP_SD_ENTRY_SIZE;
+
+    const byte_t *its_position
+        = _data + VSOMEIP_SOMEIP_SD_ENTRIES_POS + its_entries_length;
+    std::size_t its_remaining = std::size_t(options_end_ - its_position);
+    if (its_remaining > 0) {
+        if (its_remaining < sizeof(uint32_t))
+            return;
+
+        uint32_t its_options_length = VSOMEIP_BYTES_TO_LONG(
+                its_position[0], its_position[1],
+                its_position[2], its_position[3]);
+        its_position += sizeof(uint32_t);
+        its_remaining -= sizeof(uint32_t);
+
+        if (its_remaining < its_options_length)
+            return;
+
+        // unreferenced data behind the last option is discarded
+        options_end_ = its_position + its_options_length;
+
+        while (its_position < options_end_) {
+            if (options_end_ - its_position < VSOMEIP_SOMEIP_SD_OPTION_HEADER_SIZE)
+                return;
+
+            uint16_t its_length = VSOMEIP_BYTES_TO_WORD(
+                    its_position[0], its_position[1]);
+            if (options_end_ - its_position
+                    < VSOMEIP_SOMEIP_SD_OPTION_HEADER_SIZE + its_length)
+                return;
+
+            options_.push_back(its_position);
+            its_position += VSOMEIP_SOMEIP_SD_OPTION_HEADER_SIZE + its_length;
+        }
+    }
+
+    is_valid_ = true;
+}
+
+bool message_view::is_valid() const {
+    return is_valid_;
+}
+
+session_t message_view::get_session() const {
+    return VSOMEIP_BYTES_TO_WORD(data_[VSOMEIP_SESSION_POS_MIN],
+            data_[VSOMEIP_SESSION_POS_MAX]);
+}
+
+bool message_view::get_reboot_flag() const {
+    return ((data_[VSOMEIP_SOMEIP_SD_FLAGS_POS] & VSOMEIP_REBOOT_FLAG) != 0);
+}
+
+protocol_version_t message_view::get_protocol_version() const {
+    return data_[VSOMEIP_PROTOCOL_VERSION_POS];
+}
+
+interface_version_t message_view::get_interface_version() const {
+    return data_[VSOMEIP_INTERFACE_VERSION_POS];
+}
+
+message_type_e message_view::get_message_type() const {
+    return static_cast<message_type_e>(data_[VSOMEIP_MESSAGE_TYPE_POS]);
+}
+
+std::size_t message_view::get_num_entries() const {
+    return num_entries_;
+}
+
+message_view::entry_view message_view::get_entry(std::size_t _index) const {
+    return entry_view(data_ + VSOMEIP_SOMEIP_SD_ENTRIES_POS
+            + _index * VSOMEIP_SOMEIP_SD_ENTRY_SIZE);
+}
+
+bool message_view::get_option(uint8_t _index,
+        const byte_t *&_data, std::size_t &_size) const {
+    if (_index >= options_.size())
+        return false;
+
+    _data = options_[_index];
+    _size = VSOMEIP_SOMEIP_SD_OPTION_HEADER_SIZE
+            + VSOMEIP_BYTES_TO_WORD(_data[0], _data[1]);
+    return true;
+}
+
+} // namespace sd
+} // namespace vsomeip
@@ -0,0 +1,96 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "../include/message_view.hpp"
+#include "../include/remote_offers.hpp"
+#include "../../utility/include/byteorder.hpp"
+
+namespace vsomeip {
+namespace sd {
+
+bool remote_offers::is_unchanged(const message_view &_view,
+        const boost::asio::ip::address &_sender) const {
+    auto found_sender = offers_.find(_sender);
+    if (found_sender == offers_.end() || 0 == _view.get_num_entries())
+        return false;
+
+    std::vector<byte_t> its_signature;
+    for (std::size_t i = 0; i < _view.get_num_entries(); ++i) {
+        message_view::entry_view its_entry = _view.get_entry(i);
+        if (its_entry.get_type() != entry_type_e::OFFER_SERVICE
+                || 0 == its_entry.get_ttl())
+            return false;
+
+        auto found_service = found_sender->second.find(its_entry.get_service());
+        if (found_service == found_sender->second.end())
+            return false;
+        auto found_instance = found_service->second.find(its_entry.get_instance());
+        if (found_instance == found_service->second.end())
+            return false;
+
+        its_signature.clear();
+        if (!get_signature(_view, i, its_signature)
+                || its_signature != found_instance->second)
+            return false;
+    }
+    return true;
+}
+
+void remote_offers::update(const message_view &_view,
+        const boost::asio::ip::address &_sender) {
+    for (std::size_t i = 0; i < _view.get_num_entries(); ++i) {
+        message_view::entry_view its_entry = _view.get_entry(i);
+        if (its_entry.get_type() != entry_type_e::OFFER_SERVICE)
+            continue;
+
+        if (0 < its_entry.get_ttl()) {
+            std::vector<byte_t> &its_signature
+                = offers_[_sender][its_entry.get_service()][its_entry.get_instance()];
+            its_signature.clear();
+            if (!get_signature(_view, i, its_signature))
+                offers_[_sender][its_entry.get_service()].erase(
+                        its_entry.get_instance());
+        } else {
+            auto found_sender = offers_.find(_sender);
+            if (found_sender != offers_.end()) {
+                auto found_service
+                    = found_sender->second.find(its_entry.get_service());
+                if (found_service != found_sender->second.end())
+                    found_service->second.erase(its_entry.get_instance());
+            }
+        }
+    }
+}
+
+void remote_offers::remove(const boost::asio::ip::address &_sender) {
+    offers_.erase(_sender);
+}
+
+bool remote_offers::get_signature(const message_view &_view,
+        std::size_t _index, std::vector<byte_t> &_signature) {
+    message_view::entry_view its_entry = _view.get_entry(_index);
+
+    minor_version_t its_minor = its_entry.get_minor_version();
+    _signature.push_back(its_entry.get_major_version());
+    _signature.push_back(VSOMEIP_LONG_BYTE3(its_minor));
+    _signature.push_back(VSOMEIP_LONG_BYTE2(its_minor));
+    _signature.push_back(VSOMEIP_LONG_BYTE1(its_minor));
+    _signature.push_back(VSOMEIP_LONG_BYTE0(its_minor));
+
+    for (auto i : { 1, 2 }) {
+        uint8_t its_index = its_entry.get_option_index(uint8_t(i));
+        for (uint8_t j = 0; j < its_entry.get_num_options(uint8_t(i)); ++j) {
+            const byte_t *its_data;
+            std::size_t its_size;
+            if (!_view.get_option(uint8_t(its_index + j), its_data, its_size))
+                return false;
+            _signature.insert(_signature.end(), its_data, its_data + its_size);
+        }
+    }
+    return true;
+}
+
+} // namespace sd
+} // namespace vsomeip
@@ -13,6 +13,7 @@
 #include "../include/ipv4_option_impl.hpp"
 #include "../include/ipv6_option_impl.hpp"
 #include "../include/message_impl.hpp"
+#include "../include/message_view.hpp"
 #include "../include/request.hpp"
 #include "../include/runtime.hpp"
 #include "../include/service_discovery_fsm.hpp"
@@ -30,6 +31,7 @@
 #include "../../message/include/serializer.hpp"
 #include "../../routing/include/eventgroupinfo.hpp"
 #include "../../routing/include/serviceinfo.hpp"
+#include "../../utility/include/byteorder.hpp"
 
 namespace vsomeip {
 namespace sd {
@@ -39,8 +41,7 @@ service_discovery_impl::service_discovery_impl(service_discovery_host *_host)
           host_(_host),
           serializer_(std::make_shared<serializer>()),
           deserializer_(std::make_shared<deserializer>()),
-          ttl_timer_(_host->get_io()),
-          smallest_ttl_(DEFAULT_TTL) {
+          is_offer_cache_valid_(false) {
 }
 
 service_discovery_impl::~service_discovery_impl() {
@@ -369,59 +370,35 @@ void service_discovery_impl::insert_option(
         std::shared_ptr<entry_impl> _entry,
         const boost::asio::ip::address &_address, uint16_t _port,
         bool _is_reliable) {
-    if (unicast_ == _address) {
-        if (unicast_.is_v4()) {
-            ipv4_address_t its_address = unicast_.to_v4().to_bytes();
-            std::shared_ptr < ipv4_option_impl > its_option =
-                    _message->create_ipv4_option(false);
-            if (its_option) {
-                its_option->set_address(its_address);
-                its_option->set_port(_port);
-                its_option->set_layer_four_protocol(
-                        _is_reliable ? layer_four_protocol_e::TCP :
-                                layer_four_protocol_e::UDP);
-                _entry->assign_option(its_option, 1);
-            }
-        } else {
-            ipv6_address_t its_address = unicast_.to_v6().to_bytes();
-            std::shared_ptr < ipv6_option_impl > its_option =
-                    _message->create_ipv6_option(false);
-            if (its_option) {
-                its_option->set_address(its_address);
-                its_option->set_port(_port);
-                its_option->set_layer_four_protocol(
-                        _is_reliable ? layer_four_protocol_e::TCP :
-                                layer_four_protocol_e::UDP);
-                _entry->assign_option(its_option, 1);
-            }
+    bool is_multicast(unicast_ != _address);
+    std::shared_ptr < ip_option_impl > its_option;
+    if (_address.is_v4()) {
+        std::shared_ptr < ipv4_option_impl > its_ipv4_option =
+                _message->create_ipv4_option(is_multicast);
+        if (its_ipv4_option) {
+            its_ipv4_option->set_address(_address.to_v4().to_bytes());
+            its_option = its_ipv4_option;
         }
     } else {
-        if (_address.is_v4()) {
-            ipv4_address_t its_address = _address.to_v4().to_bytes();
-            std::shared_ptr < ipv4_option_impl > its_option =
-                    _message->create_ipv4_option(true);
-            if (its_option) {
-                its_option->set_address(its_address);
-                its_option->set_port(_port);
-                its_option->set_layer_four_protocol(
-                        _is_reliable ? layer_four_protocol_e::TCP :
-                                layer_four_protocol_e::UDP);
-                _entry->assign_option(its_option, 1);
-            }
-        } else {
-            ipv6_address_t its_address = _address.to_v6().to_bytes();
-            std::shared_ptr < ipv6_option_impl > its_option =
-                    _message->create_ipv6_option(true);
-            if (its_option) {
-                its_option->set_address(its_address);
-                its_option->set_port(_port);
-                its_option->set_layer_four_protocol(
-                        _is_reliable ? layer_four_protocol_e::TCP :
-                                layer_four_protocol_e::UDP);
-                _entry->assign_option(its_option, 1);
-            }
+        std::shared_ptr < ipv6_option_impl > its_ipv6_option =
+                _message->create_ipv6_option(is_multicast);
+        if (its_ipv6_option) {
+            its_ipv6_option->set_address(_address.to_v6().to_bytes());
+            its_option = its_ipv6_option;
         }
     }
+
+    if (its_option) {
+        its_option->set_port(_port);
+        its_option->set_layer_four_protocol(
+                _is_reliable ? layer_four_protocol_e::TCP :
+                        layer_four_protocol_e::UDP);
+
+        // Entries refer to a shared option. As the options of a run must be
+        // consecutive, each run refers to a single option then.
+        _entry->assign_option(_message->merge_option(its_option),
+                uint8_t(_entry->get_options(1).empty() ? 1 : 2));
+    }
 }
 
 void service_discovery_impl::insert_find_entries(
@@ -525,6 +502,11 @@ void service_discovery_impl::insert_subscription_nack(
 }
 
 void service_discovery_impl::send(bool _is_announcing) {
+    // In main phase, only the "OfferService"-entries are sent
+    if (_is_announcing) {
+        send_offers();
+        return;
+    }
 
     std::shared_ptr < runtime > its_runtime = runtime_.lock();
     if (!its_runtime)
@@ -533,12 +515,8 @@ void service_discovery_impl::send(bool _is_announcing) {
     std::shared_ptr < message_impl > its_message =
             its_runtime->create_message();
 
-    // TODO: optimize building of SD message (common options, utilize the two runs)
-
     // If we are not in main phase, include "FindOffer"-entries
-    if (!_is_announcing) {
-        insert_find_entries(its_message, requested_);
-    }
+    insert_find_entries(its_message, requested_);
 
     // Always include the "OfferService"-entries for the service group
     services_t its_offers = host_->get_offered_services();
@@ -555,6 +533,59 @@ void service_discovery_impl::send(bool _is_announcing) {
     }
 }
 
+void service_discovery_impl::send_offers() {
+    std::lock_guard<std::mutex> its_lock(offer_cache_mutex_);
+    if (!is_offer_cache_valid_) {
+        std::shared_ptr < runtime > its_runtime = runtime_.lock();
+        if (!its_runtime)
+            return;
+
+        std::shared_ptr < message_impl > its_message =
+                its_runtime->create_message();
+        services_t its_offers = host_->get_offered_services();
+        insert_offer_entries(its_message, its_offers);
+
+        offer_cache_.clear();
+        if (its_message->get_entries().size() > 0) {
+            if (!serializer_->serialize(its_message.get())) {
+                VSOMEIP_ERROR << "service_discovery_impl::send_offers: serialization error.";
+                serializer_->reset();
+                return;
+            }
+            offer_cache_.assign(serializer_->get_data(),
+                    serializer_->get_data() + serializer_->get_size());
+            serializer_->reset();
+        }
+
+        // Stopped offers (TTL=0) must be sent only once
+        is_offer_cache_valid_ = true;
+        for (auto its_service : its_offers) {
+            for (auto its_instance : its_service.second) {
+                if (0 == its_instance.second->get_ttl())
+                    is_offer_cache_valid_ = false;
+            }
+        }
+    }
+
+    if (offer_cache_.size() > 0) {
+        std::pair<session_t, bool> its_session = get_session(unicast_);
+        offer_cache_[VSOMEIP_SESSION_POS_MIN]
+            = VSOMEIP_WORD_BYTE1(its_session.first);
+        offer_cache_[VSOMEIP_SESSION_POS_MAX]
+            = VSOMEIP_WORD_BYTE0(its_session.first);
+        if (its_session.second) {
+            offer_cache_[VSOMEIP_SOMEIP_SD_FLAGS_POS] |= VSOMEIP_REBOOT_FLAG;
+        } else {
+            offer_cache_[VSOMEIP_SOMEIP_SD_FLAGS_POS] &= byte_t(~VSOMEIP_REBOOT_FLAG);
+        }
+        if (host_->send(VSOMEIP_SD_CLIENT, &offer_cache_[0],
+                uint32_t(offer_cache_.size()), VSOMEIP_SD_INSTANCE,
+                true, false)) {
+            increment_session(unicast_);
+        }
+    }
+}
+
 // Interface endpoint_host
 void service_discovery_impl::on_message(const byte_t *_data, length_t _length,
         const boost::asio::ip::address &_sender) {
@@ -565,24 +596,31 @@ void service_discovery_impl::on_message(const byte_t *_data, length_t _length,
     msg << std::hex << std::setw(2) << std::setfill('0') << (int)_data[i] << " ";
     VSOMEIP_DEBUG << msg.str();
 #endif
+    message_view its_view(_data, _length);
+    if (!its_view.is_valid()) {
+        VSOMEIP_ERROR << "service_discovery_impl::on_message: deserialization error.";
+        return;
+    }
+
+    // ignore all messages which are sent with invalid header fields
+    if (!check_static_header_fields(its_view)) {
+        return;
+    }
+
+    // Expire all subscriptions / services in case of reboot
+    if (is_reboot(_sender,
+            its_view.get_reboot_flag(), its_view.get_session())) {
+        host_->expire_subscriptions(_sender);
+        host_->expire_services(_sender);
+        offers_.remove(_sender);
+    } else if (refresh_offers(its_view, _sender)) {
+        return;
+    }
+
     deserializer_->set_data(_data, _length);
     std::shared_ptr < message_impl
             > its_message(deserializer_->deserialize_sd_message());
     if (its_message) {
-        // ignore all messages which are sent with invalid header fields
-        if(!check_static_header_fields(its_message)) {
-            return;
-        }
-        // Expire all subscriptions / services in case of reboot
-        if (is_reboot(_sender,
-                its_message->get_reboot_flag(), its_message->get_session())) {
-            host_->expire_subscriptions(_sender);
-            host_->expire_services(_sender);
-        }
-
-        ttl_t expired = stop_ttl_timer();
-        smallest_ttl_ = host_->update_routing_info(expired);
-
         std::vector < std::shared_ptr<option_impl> > its_options =
                 its_message->get_options();
         for (auto its_entry : its_message->get_entries()) {
@@ -598,7 +636,8 @@ void service_discovery_impl::on_message(const byte_t *_data, length_t _length,
                 process_eventgroupentry(its_eventgroup_entry, its_options);
             }
         }
-        start_ttl_timer();
+        offers_.update(its_view, _sender);
+        send_acknowledgements();
     } else {
         VSOMEIP_ERROR << "service_discovery_impl::on_message: deserialization error.";
         return;
@@ -606,9 +645,55 @@ void service_discovery_impl::on_message(const byte_t *_data, length_t _length,
 }
 
 void service_discovery_impl::on_offer_change() {
+    {
+        std::lock_guard<std::mutex> its_lock(offer_cache_mutex_);
+        is_offer_cache_valid_ = false;
+    }
     default_->process(ev_offer_change());
 }
 
+// Offers that only repeat the last offer of the sender are handled without
+// deserializing the message
+bool service_discovery_impl::refresh_offers(const message_view &_view,
+        const boost::asio::ip::address &_sender) {
+    if (!offers_.is_unchanged(_view, _sender))
+        return false;
+
+    // Acknowledged subscriptions are renewed by the full processing
+    for (std::size_t i = 0; i < _view.get_num_entries(); ++i) {
+        message_view::entry_view its_entry = _view.get_entry(i);
+        if (is_acknowledged(its_entry.get_service(), its_entry.get_instance()))
+            return false;
+    }
+
+    for (std::size_t i = 0; i < _view.get_num_entries(); ++i) {
+        message_view::entry_view its_entry = _view.get_entry(i);
+        if (!host_->refresh_routing_info(its_entry.get_service(),
+                its_entry.get_instance(), its_entry.get_ttl()))
+            return false;
+    }
+
+    return true;
+}
+
+bool service_discovery_impl::is_acknowledged(service_t _service,
+        instance_t _instance) {
+    std::lock_guard<std::mutex> its_lock(subscribed_mutex_);
+    auto found_service = subscribed_.find(_service);
+    if (found_service != subscribed_.end()) {
+        auto found_instance = found_service->second.find(_instance);
+        if (found_instance != found_service->second.end()) {
+            for (auto its_eventgroup : found_instance->second) {
+                for (auto its_client : its_eventgroup.second) {
+                    if (its_client.second->is_acknowledged())
+                        return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
 // Entry processing
 void service_discovery_impl::process_serviceentry(
         std::shared_ptr<serviceentry_impl> &_entry,
@@ -1052,17 +1137,11 @@ void service_discovery_impl::handle_eventgroup_subscription(service_t _service,
         ttl_t _ttl, const boost::asio::ip::address &_address,
         uint16_t _reliable_port, uint16_t _unreliable_port) {
 
-    std::shared_ptr < runtime > its_runtime = runtime_.lock();
-    if (!its_runtime)
-        return;
-
-    std::shared_ptr < message_impl > its_message =
-            its_runtime->create_message();
+    std::shared_ptr < message_impl > its_message = get_acknowledgement(_address);
     if (its_message) {
         std::shared_ptr < eventgroupinfo > its_info = host_->find_eventgroup(
                 _service, _instance, _eventgroup);
 
-        bool is_nack(false);
         std::shared_ptr < endpoint_definition > its_reliable_subscriber,
             its_unreliable_subscriber;
         std::shared_ptr < endpoint_definition > its_reliable_target,
@@ -1072,10 +1151,8 @@ void service_discovery_impl::handle_eventgroup_subscription(service_t _service,
         if (!its_info || _major != its_info->get_major()) {
             // Create a temporary info object with TTL=0 --> send NACK
             its_info = std::make_shared < eventgroupinfo > (_major, 0);
-            is_nack = true;
             insert_subscription_nack(its_message, _service, _instance, _eventgroup,
                 its_info);
-            serialize_and_send(its_message, _address);
             //TODO add check if required tcp connection is open
             return;
         } else {
@@ -1112,18 +1189,19 @@ void service_discovery_impl::handle_eventgroup_subscription(service_t _service,
         insert_subscription_ack(its_message, _service, _instance, _eventgroup,
                 its_info, _ttl);
 
-        serialize_and_send(its_message, _address);
-
         // Finally register the new subscriber and send him all the fields(!)
-        if (!is_nack) {
-            if (its_unreliable_target && its_unreliable_subscriber) {
-                host_->on_subscribe(_service, _instance, _eventgroup,
-                        its_unreliable_subscriber, its_unreliable_target);
-            }
-            if (its_reliable_target && its_reliable_subscriber) {
-                host_->on_subscribe(_service, _instance, _eventgroup,
-                        its_reliable_subscriber, its_reliable_target);
-            }
+        // as soon as the acknowledgement was sent
+        if (its_unreliable_target && its_unreliable_subscriber) {
+            subscribers_.push_back(
+                    std::bind(&service_discovery_host::on_subscribe, host_,
+                            _service, _instance, _eventgroup,
+                            its_unreliable_subscriber, its_unreliable_target));
+        }
+        if (its_reliable_target && its_reliable_subscriber) {
+            subscribers_.push_back(
+                    std::bind(&service_discovery_host::on_subscribe, host_,
+                            _service, _instance, _eventgroup,
+                            its_reliable_subscriber, its_reliable_target));
         }
     }
 }
@@ -1154,6 +1232,37 @@ void service_discovery_impl::handle_eventgroup_subscription_ack(
     }
 }
 
+std::shared_ptr<message_impl> service_discovery_impl::get_acknowledgement(
+        const boost::asio::ip::address &_address) {
+    std::vector<std::shared_ptr<message_impl> > &its_messages
+        = acknowledgements_[_address];
+    // Each (N)ACK adds an entry and at most one (multicast) option
+    if (its_messages.empty()
+            || its_messages.back()->get_length() + VSOMEIP_SOMEIP_SD_ENTRY_SIZE
+                + VSOMEIP_SOMEIP_SD_IPV6_OPTION_SIZE
+                    > VSOMEIP_MAX_UDP_MESSAGE_SIZE) {
+        std::shared_ptr<runtime> its_runtime = runtime_.lock();
+        if (!its_runtime)
+            return nullptr;
+        its_messages.push_back(its_runtime->create_message());
+    }
+    return its_messages.back();
+}
+
+void service_discovery_impl::send_acknowledgements() {
+    for (auto &its_acknowledgement : acknowledgements_) {
+        for (auto &its_message : its_acknowledgement.second) {
+            if (0 < its_message->get_entries().size())
+                serialize_and_send(its_message, its_acknowledgement.first);
+        }
+    }
+    acknowledgements_.clear();
+
+    for (auto &its_subscriber : subscribers_)
+        its_subscriber();
+    subscribers_.clear();
+}
+
 void service_discovery_impl::serialize_and_send(
         std::shared_ptr<message_impl> _message,
         const boost::asio::ip::address &_address) {
@@ -1171,28 +1280,6 @@ void service_discovery_impl::serialize_and_send(
     serializer_->reset();
 }
 
-void service_discovery_impl::start_ttl_timer() {
-    ttl_timer_.expires_from_now(std::chrono::seconds(smallest_ttl_));
-    ttl_timer_.async_wait(
-            std::bind(&service_discovery_impl::check_ttl, shared_from_this(),
-                      std::placeholders::_1));
-}
-
-ttl_t service_discovery_impl::stop_ttl_timer() {
-    ttl_t remaining = ttl_t(std::chrono::duration_cast<
-                                std::chrono::seconds
-                            >(ttl_timer_.expires_from_now()).count());
-    ttl_timer_.cancel();
-    return (smallest_ttl_ - remaining);
-}
-
-void service_discovery_impl::check_ttl(const boost::system::error_code &_error) {
-    if (!_error) {
-        smallest_ttl_ = host_->update_routing_info(smallest_ttl_);
-        start_ttl_timer();
-    }
-}
-
 boost::asio::ip::address service_discovery_impl::get_current_remote_address() const {
     if (reliable_) {
         return std::static_pointer_cast<tcp_server_endpoint_impl>(endpoint_)->get_remote().address();
@@ -1202,16 +1289,16 @@ boost::asio::ip::address service_discovery_impl::get_current_remote_address() co
 }
 
 bool service_discovery_impl::check_static_header_fields(
-        const std::shared_ptr<const message> &_message) const {
-    if(_message->get_protocol_version() != protocol_version) {
+        const message_view &_view) const {
+    if(_view.get_protocol_version() != protocol_version) {
         VSOMEIP_ERROR << "Invalid protocol version in SD header";
         return false;
     }
-    if(_message->get_interface_version() != interface_version) {
+    if(_view.get_interface_version() != interface_version) {
         VSOMEIP_ERROR << "Invalid interface version in SD header";
         return false;
     }
-    if(_message->get_message_type() != message_type) {
+    if(_view.get_message_type() != message_type) {
         VSOMEIP_ERROR << "Invalid message type in SD header";
         return false;
     }
@@ -1220,11 +1307,8 @@ bool service_discovery_impl::check_static_header_fields(
 
 void service_discovery_impl::send_eventgroup_subscription_nack(
         service_t _service, instance_t _instance, eventgroup_t _eventgroup, major_version_t _major) {
-    std::shared_ptr<runtime> its_runtime = runtime_.lock();
-    if (!its_runtime) {
-        return;
-    }
-    std::shared_ptr<message_impl> its_message = its_runtime->create_message();
+    std::shared_ptr<message_impl> its_message
+        = get_acknowledgement(get_current_remote_address());
     if (its_message) {
         std::shared_ptr<eventgroupinfo> its_info = host_->find_eventgroup(
                 _service, _instance, _eventgroup);
@@ -1234,7 +1318,6 @@ void service_discovery_impl::send_eventgroup_subscription_nack(
         }
         insert_subscription_nack(its_message, _service, _instance, _eventgroup,
                 its_info);
-        serialize_and_send(its_message, get_current_remote_address());
     }
 }
 
@@ -0,0 +1,108 @@
+// Copyright (C) 2014-2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef VSOMEIP_TIMER_WHEEL_HPP
+#define VSOMEIP_TIMER_WHEEL_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace vsomeip {
+
+// Hashed timer wheel. Each key is stored in the slot of the tick it
+// expires in. Keys that expire more than one revolution ahead share their
+// slot with earlier ones and are skipped until their tick is reached.
+// The wheel does not read a clock, its owner advances it tick by tick
+// from the first schedule until the wheel is empty after an advance.
+template<typename Key>
+class timer_wheel {
+public:
+    timer_wheel(std::chrono::milliseconds _tick, std::size_t _size)
+        : tick_(_tick), slots_(_size), now_(0), is_running_(false) {
+    }
+
+    std::chrono::milliseconds get_tick() const {
+        return tick_;
+    }
+
+    bool empty() const {
+        return expirations_.empty();
+    }
+
+    // Schedules the key to expire after at least _delay. If the key is
+    // already scheduled, the earlier expiration is kept. While the wheel
+    // is running, part of the current tick has already elapsed and does
+    // not count towards the delay.
+    void schedule(const Key &_key, std::chrono::milliseconds _delay) {
+        std::uint64_t its_expiration = now_ + get_ticks(_delay);
+        if (is_running_)
+            its_expiration++;
+        is_running_ = true;
+        auto found_key = expirations_.find(_key);
+        if (found_key != expirations_.end()) {
+            if (found_key->second <= its_expiration)
+                return;
+            slots_[get_slot(found_key->second)].erase(_key);
+            found_key->second = its_expiration;
+        } else {
+            expirations_[_key] = its_expiration;
+        }
+        slots_[get_slot(its_expiration)].insert(_key);
+    }
+
+    void cancel(const Key &_key) {
+        auto found_key = expirations_.find(_key);
+        if (found_key != expirations_.end()) {
+            slots_[get_slot(found_key->second)].erase(_key);
+            expirations_.erase(found_key);
+        }
+    }
+
+    // Moves the wheel forward by one tick and appends the expired keys.
+    void advance(std::vector<Key> &_expired) {
+        now_++;
+        std::set<Key> &its_slot = slots_[get_slot(now_)];
+        for (auto i = its_slot.begin(); i != its_slot.end();) {
+            auto found_key = expirations_.find(*i);
+            if (found_key->second <= now_) {
+                _expired.push_back(*i);
+                expirations_.erase(found_key);
+                i = its_slot.erase(i);
+            } else {
+                ++i;
+            }
+        }
+        if (expirations_.empty())
+            is_running_ = false;
+    }
+
+private:
+    std::uint64_t get_ticks(std::chrono::milliseconds _delay) const {
+        std::uint64_t its_ticks(0);
+        if (_delay.count() > 0) {
+            its_ticks = std::uint64_t(
+                    (_delay.count() + tick_.count() - 1) / tick_.count());
+        }
+        return (its_ticks > 0 ? its_ticks : 1);
+    }
+
+    std::size_t get_slot(std::uint64_t _tick) const {
+        return std::size_t(_tick % slots_.size());
+    }
+
+    std::chrono::milliseconds tick_;
+    std::vector<std::set<Key> > slots_;
+    std::map<Key, std::uint64_t> expirations_;
+    std::uint64_t now_;
+    bool is_running_;
+};
+
+} // namespace vsomeip
+
+#endif // VSOMEIP_TIMER_WHEEL_HPP
@@ -58,6 +58,17 @@ public:
         return (_type == message_type_e::MT_NOTIFICATION);
     }
 
+    // Packed identifiers to be used as keys of hash tables and as the
+    // default dispatch keys of service instances
+    static inline uint32_t get_key(service_t _service, instance_t _instance) {
+        return ((uint32_t(_service) << 16) | _instance);
+    }
+
+    static inline uint64_t get_key(service_t _service, instance_t _instance,
+            uint16_t _id) {
+        return ((uint64_t(_service) << 32) | (uint64_t(_instance) << 16) | _id);
+    }
+
     static uint32_t get_message_size(const byte_t *_data, uint32_t _size);
     static inline uint32_t get_message_size(std::vector<byte_t> &_data) {
         if (_data.size() > 0) {
@@ -106,6 +106,13 @@ public:
             subscription_handler_t _handler) = 0;
     virtual void unregister_subscription_handler(service_t _service,
                 instance_t _instance, eventgroup_t _eventgroup) = 0;
+
+    // [Un]Register handler that computes the key messages are ordered by
+    // if ordered dispatching is configured (default: service and instance).
+    // Not pure to keep existing implementations of this interface valid.
+    virtual void register_dispatch_key_handler(
+            dispatch_key_handler_t /*_handler*/) {}
+    virtual void unregister_dispatch_key_handler() {}
 };
 
 } // namespace vsomeip
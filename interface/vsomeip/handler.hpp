@@ -19,6 +19,7 @@ typedef std::function< void (state_type_e) > state_handler_t;
 typedef std::function< void (const std::shared_ptr< message > &) > message_handler_t;
 typedef std::function< void (service_t, instance_t, bool) > availability_handler_t;
 typedef std::function< bool (client_t, bool) > subscription_handler_t;
+typedef std::function< uint32_t (const std::shared_ptr< message > &) > dispatch_key_handler_t;
 
 } // namespace vsomeip
 
@@ -33,6 +33,12 @@ public:
     VSOMEIP_EXPORT virtual length_t get_length() const = 0;
 
     VSOMEIP_EXPORT virtual void set_capacity(length_t _length) = 0;
+
+    // Received payloads may reference the buffer they were received into.
+    // Detaching copies the data so that keeping the payload does not keep
+    // the whole receive buffer alive. Not pure to keep existing
+    // implementations of this interface valid; those own their data.
+    VSOMEIP_EXPORT virtual void detach() {}
 };
 
 } // namespace vsomeip
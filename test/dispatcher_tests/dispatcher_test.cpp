@@ -0,0 +1,235 @@
+// Copyright (C) 2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <vsomeip/vsomeip.hpp>
+
+#include "../implementation/runtime/include/dispatcher.hpp"
+
+namespace {
+
+const std::chrono::seconds TIMEOUT(10);
+
+// Waits until the counter reached the expected value
+bool wait_for(const std::atomic<std::size_t> &_counter, std::size_t _expected) {
+    std::chrono::steady_clock::time_point its_end
+        = std::chrono::steady_clock::now() + TIMEOUT;
+    while (_counter.load() < _expected) {
+        if (std::chrono::steady_clock::now() > its_end)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace
+
+class dispatcher_test: public ::testing::Test
+{
+protected:
+    virtual void TearDown() {
+        if (dispatcher_) {
+            dispatcher_->stop();
+            for (auto &its_thread : threads_)
+                its_thread.join();
+        }
+    }
+
+    void create(std::size_t _num_threads, std::size_t _queue_size,
+            bool _is_ordered) {
+        dispatcher_ = std::make_shared<vsomeip::dispatcher>(
+                _num_threads, _queue_size, _is_ordered);
+        dispatcher_->start();
+    }
+
+    void run() {
+        for (std::size_t i = 0; i < dispatcher_->get_num_threads(); i++)
+            threads_.push_back(std::thread(
+                    &vsomeip::dispatcher::run, dispatcher_.get(), i));
+    }
+
+    std::shared_ptr<vsomeip::dispatcher> dispatcher_;
+    std::vector<std::thread> threads_;
+};
+
+TEST_F(dispatcher_test, pass_messages_to_handlers)
+{
+    create(2, 8, false);
+    run();
+
+    std::shared_ptr<vsomeip::message> its_message
+        = vsomeip::runtime::get()->create_request();
+    its_message->set_service(0x1234);
+
+    std::atomic<std::size_t> its_count(0);
+    std::atomic<std::size_t> its_errors(0);
+    for (int i = 0; i < 100; i++) {
+        dispatcher_->dispatch(0,
+                [&](const std::shared_ptr<vsomeip::message> &_message) {
+                    if (_message != its_message)
+                        its_errors++;
+                    its_count++;
+                }, its_message);
+    }
+    ASSERT_TRUE(wait_for(its_count, 100));
+    ASSERT_EQ(0u, its_errors.load());
+}
+
+TEST_F(dispatcher_test, keep_order_on_overflow)
+{
+    // The tasks are queued before the thread runs, so that all but the
+    // first ones go to the overflow queue
+    create(1, 2, false);
+
+    std::mutex its_mutex;
+    std::vector<int> its_order;
+    std::atomic<std::size_t> its_count(0);
+    for (int i = 0; i < 1000; i++) {
+        dispatcher_->dispatch(0, [&, i]() {
+            std::lock_guard<std::mutex> its_lock(its_mutex);
+            its_order.push_back(i);
+            its_count++;
+        });
+    }
+
+    run();
+    ASSERT_TRUE(wait_for(its_count, 1000));
+
+    // Tasks that are dispatched while the overflow queue is drained
+    for (int i = 1000; i < 2000; i++) {
+        dispatcher_->dispatch(0, [&, i]() {
+            std::lock_guard<std::mutex> its_lock(its_mutex);
+            its_order.push_back(i);
+            its_count++;
+        });
+    }
+    ASSERT_TRUE(wait_for(its_count, 2000));
+
+    std::lock_guard<std::mutex> its_lock(its_mutex);
+    for (int i = 0; i < 2000; i++)
+        ASSERT_EQ(i, its_order[i]);
+}
+
+TEST_F(dispatcher_test, run_tasks_of_concurrent_producers)
+{
+    // Small queues to make the producers contend and overflow
+    create(4, 16, false);
+    run();
+
+    const std::size_t its_num_producers = 4;
+    const std::size_t its_num_tasks = 20000;
+    std::atomic<std::size_t> its_count(0);
+    std::atomic<std::size_t> its_sum(0);
+
+    std::vector<std::thread> its_producers;
+    for (std::size_t p = 0; p < its_num_producers; p++) {
+        its_producers.push_back(std::thread([&, p]() {
+            for (std::size_t i = 0; i < its_num_tasks; i++) {
+                std::size_t its_value = p * its_num_tasks + i;
+                dispatcher_->dispatch(std::uint32_t(i), [&, its_value]() {
+                    its_sum += its_value;
+                    its_count++;
+                });
+            }
+        }));
+    }
+    for (auto &its_producer : its_producers)
+        its_producer.join();
+
+    const std::size_t its_total = its_num_producers * its_num_tasks;
+    ASSERT_TRUE(wait_for(its_count, its_total));
+    ASSERT_EQ(its_total * (its_total - 1) / 2, its_sum.load());
+}
+
+TEST_F(dispatcher_test, steal_tasks_of_blocked_threads)
+{
+    create(2, 8, false);
+    run();
+
+    // Blocks the thread that picks it up. Tasks are distributed round
+    // robin, so half of the others are queued for the blocked thread and
+    // have to be stolen.
+    std::atomic<bool> is_blocking(true);
+    std::atomic<std::size_t> its_blocked(0);
+    dispatcher_->dispatch(0, [&]() {
+        its_blocked++;
+        while (is_blocking)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+    ASSERT_TRUE(wait_for(its_blocked, 1));
+
+    std::atomic<std::size_t> its_count(0);
+    for (int i = 0; i < 100; i++)
+        dispatcher_->dispatch(0, [&]() { its_count++; });
+
+    bool is_done = wait_for(its_count, 100);
+    is_blocking = false;
+    ASSERT_TRUE(is_done);
+}
+
+TEST_F(dispatcher_test, serialize_tasks_with_equal_keys)
+{
+    create(4, 8, true);
+    ASSERT_TRUE(dispatcher_->is_ordered());
+    run();
+
+    const std::uint32_t its_num_keys = 8;
+    const int its_num_tasks = 2000;
+    std::vector<std::vector<int> > its_orders(its_num_keys);
+    std::vector<std::unique_ptr<std::atomic<int> > > its_running;
+    for (std::uint32_t k = 0; k < its_num_keys; k++)
+        its_running.push_back(
+                std::unique_ptr<std::atomic<int> >(new std::atomic<int>(0)));
+    std::atomic<std::size_t> its_count(0);
+    std::atomic<std::size_t> its_overlaps(0);
+
+    for (int i = 0; i < its_num_tasks; i++) {
+        for (std::uint32_t k = 0; k < its_num_keys; k++) {
+            dispatcher_->dispatch(k, [&, i, k]() {
+                if (0 != (*its_running[k])++)
+                    its_overlaps++;
+                its_orders[k].push_back(i);
+                (*its_running[k])--;
+                its_count++;
+            });
+        }
+    }
+
+    ASSERT_TRUE(wait_for(its_count, its_num_keys * its_num_tasks));
+    ASSERT_EQ(0u, its_overlaps.load());
+    for (std::uint32_t k = 0; k < its_num_keys; k++) {
+        ASSERT_EQ(std::size_t(its_num_tasks), its_orders[k].size());
+        for (int i = 0; i < its_num_tasks; i++)
+            ASSERT_EQ(i, its_orders[k][i]);
+    }
+}
+
+TEST_F(dispatcher_test, stop_idle_threads)
+{
+    create(3, 8, false);
+    run();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    // Sleeping threads return once the dispatcher stops
+    dispatcher_->stop();
+    for (auto &its_thread : threads_)
+        its_thread.join();
+    threads_.clear();
+}
+
+#ifndef WIN32
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+#endif
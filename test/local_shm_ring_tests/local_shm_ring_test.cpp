@@ -0,0 +1,237 @@
+// Copyright (C) 2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "../implementation/endpoints/include/local_shm_ring.hpp"
+
+namespace {
+
+const std::uint32_t RING_SIZE = 256;
+
+std::vector<vsomeip::byte_t> create_record(std::uint32_t _number,
+        std::uint32_t _size) {
+    std::vector<vsomeip::byte_t> its_record(_size);
+    for (std::uint32_t i = 0; i < _size; i++)
+        its_record[i] = vsomeip::byte_t(_number + i);
+    return its_record;
+}
+
+} // namespace
+
+class local_shm_ring_test: public ::testing::Test
+{
+protected:
+    virtual void SetUp() {
+        std::stringstream its_name;
+        its_name << "/vsomeip-local-shm-ring-test-" << getpid();
+        producer_ = vsomeip::local_shm_ring::create(its_name.str(), RING_SIZE);
+        ASSERT_TRUE(producer_ != nullptr);
+        consumer_ = vsomeip::local_shm_ring::open(its_name.str());
+        ASSERT_TRUE(consumer_ != nullptr);
+    }
+
+    virtual void TearDown() {
+        if (producer_)
+            producer_->unlink();
+    }
+
+    bool push(std::uint32_t _number, std::uint32_t _size) {
+        std::vector<vsomeip::byte_t> its_record = create_record(_number, _size);
+        return producer_->push(its_record.data(), _size);
+    }
+
+    // Reads the next record and checks that it is the expected one
+    void pop(std::uint32_t _number, std::uint32_t _size) {
+        const vsomeip::byte_t *its_data(nullptr);
+        std::uint32_t its_size(0);
+        ASSERT_TRUE(consumer_->front(its_data, its_size));
+        ASSERT_EQ(_size, its_size);
+        ASSERT_EQ(create_record(_number, _size),
+                std::vector<vsomeip::byte_t>(its_data, its_data + its_size));
+        consumer_->pop(its_size);
+    }
+
+    bool is_empty() {
+        const vsomeip::byte_t *its_data(nullptr);
+        std::uint32_t its_size(0);
+        return !consumer_->front(its_data, its_size);
+    }
+
+    std::shared_ptr<vsomeip::local_shm_ring> producer_;
+    std::shared_ptr<vsomeip::local_shm_ring> consumer_;
+};
+
+TEST_F(local_shm_ring_test, open_created_ring)
+{
+    ASSERT_EQ(RING_SIZE, producer_->get_capacity());
+    ASSERT_EQ(RING_SIZE, consumer_->get_capacity());
+    ASSERT_EQ(producer_->get_name(), consumer_->get_name());
+    ASSERT_TRUE(is_empty());
+
+    std::shared_ptr<vsomeip::local_shm_ring> its_ring
+        = vsomeip::local_shm_ring::create(producer_->get_name() + "-odd", 100);
+    ASSERT_TRUE(its_ring != nullptr);
+    ASSERT_EQ(128u, its_ring->get_capacity());
+    its_ring->unlink();
+
+    ASSERT_TRUE(vsomeip::local_shm_ring::open(
+            producer_->get_name() + "-missing") == nullptr);
+}
+
+TEST_F(local_shm_ring_test, keep_order)
+{
+    ASSERT_TRUE(push(1, 10));
+    ASSERT_TRUE(push(2, 0));
+    ASSERT_TRUE(push(3, 33));
+    pop(1, 10);
+    pop(2, 0);
+    pop(3, 33);
+    ASSERT_TRUE(is_empty());
+}
+
+TEST_F(local_shm_ring_test, reject_oversized_records)
+{
+    // Records must not exceed half of the ring, including their length
+    ASSERT_TRUE(push(1, RING_SIZE / 2 - sizeof(std::uint32_t)));
+    ASSERT_FALSE(push(2, RING_SIZE / 2 - sizeof(std::uint32_t) + 1));
+    pop(1, RING_SIZE / 2 - sizeof(std::uint32_t));
+    ASSERT_TRUE(is_empty());
+}
+
+TEST_F(local_shm_ring_test, reject_corrupted_lengths)
+{
+    // Sizes whose record size would wrap around 32 bits
+    const vsomeip::byte_t its_byte(0);
+    ASSERT_FALSE(producer_->push(&its_byte, 0xFFFFFFFC));
+    ASSERT_FALSE(producer_->push(&its_byte, 0xFFFFFFFF - 2));
+
+    // Overwrite the length prefix of a record within the shared memory
+    ASSERT_TRUE(push(1, 4));
+    const vsomeip::byte_t *its_data(nullptr);
+    std::uint32_t its_size(0);
+    ASSERT_TRUE(consumer_->front(its_data, its_size));
+    const std::uint32_t its_length(0xFFFFFFFC);
+    std::memcpy(const_cast<vsomeip::byte_t *>(its_data) - sizeof(its_length),
+            &its_length, sizeof(its_length));
+    ASSERT_FALSE(consumer_->front(its_data, its_size));
+
+    // The corrupted records are skipped
+    ASSERT_TRUE(is_empty());
+    ASSERT_TRUE(push(2, 4));
+    pop(2, 4);
+    ASSERT_TRUE(is_empty());
+}
+
+TEST_F(local_shm_ring_test, reject_records_while_full)
+{
+    // 8 byte records, including their length
+    std::uint32_t its_number(0);
+    while (push(its_number, 4))
+        its_number++;
+    ASSERT_EQ(RING_SIZE / 8, its_number);
+
+    pop(0, 4);
+    ASSERT_FALSE(push(its_number, 8));
+    ASSERT_TRUE(push(its_number, 4));
+    ASSERT_FALSE(push(its_number + 1, 4));
+
+    for (std::uint32_t i = 1; i <= its_number; i++)
+        pop(i, 4);
+    ASSERT_TRUE(is_empty());
+}
+
+TEST_F(local_shm_ring_test, wrap_around)
+{
+    // Record sizes that do not divide the ring, so that the records wrap
+    // at different offsets and need padding
+    const std::uint32_t its_sizes[] = { 1, 17, 60, 3, 100, 45, 0, 8 };
+    std::uint32_t its_pushed(0), its_popped(0), its_bytes(0);
+    for (int its_round = 0; its_round < 500; its_round++) {
+        while (push(its_pushed, its_sizes[its_pushed % 8])) {
+            its_bytes += its_sizes[its_pushed % 8];
+            its_pushed++;
+        }
+        ASSERT_FALSE(is_empty());
+
+        // Leave some records behind to move the position of the head
+        std::uint32_t its_count = (its_pushed - its_popped + 1) / 2;
+        for (std::uint32_t i = 0; i < its_count; i++) {
+            pop(its_popped, its_sizes[its_popped % 8]);
+            its_popped++;
+        }
+    }
+    while (its_popped < its_pushed) {
+        pop(its_popped, its_sizes[its_popped % 8]);
+        its_popped++;
+    }
+    ASSERT_TRUE(is_empty());
+    ASSERT_GT(its_bytes, 100 * RING_SIZE);
+}
+
+TEST_F(local_shm_ring_test, notify_waiting_consumer)
+{
+    // A new ring starts with a waiting consumer
+    ASSERT_TRUE(producer_->notify());
+    ASSERT_FALSE(producer_->notify());
+
+    ASSERT_TRUE(consumer_->wait());
+    ASSERT_TRUE(push(1, 4));
+    ASSERT_TRUE(producer_->notify());
+    ASSERT_FALSE(producer_->notify());
+
+    // The consumer must not wait while records are available
+    ASSERT_FALSE(consumer_->wait());
+    ASSERT_FALSE(producer_->notify());
+    pop(1, 4);
+    ASSERT_TRUE(consumer_->wait());
+    ASSERT_TRUE(producer_->notify());
+}
+
+TEST_F(local_shm_ring_test, hand_over_between_threads)
+{
+    const std::uint32_t its_count = 100000;
+
+    std::thread its_producer([this, its_count]() {
+        for (std::uint32_t i = 0; i < its_count; i++) {
+            std::vector<vsomeip::byte_t> its_record
+                = create_record(i, i % 50);
+            while (!producer_->push(its_record.data(),
+                    std::uint32_t(its_record.size())))
+                std::this_thread::yield();
+        }
+    });
+
+    std::uint32_t its_errors(0);
+    for (std::uint32_t i = 0; i < its_count; i++) {
+        const vsomeip::byte_t *its_data(nullptr);
+        std::uint32_t its_size(0);
+        while (!consumer_->front(its_data, its_size))
+            std::this_thread::yield();
+        if (create_record(i, i % 50)
+                != std::vector<vsomeip::byte_t>(its_data, its_data + its_size))
+            its_errors++;
+        consumer_->pop(its_size);
+    }
+
+    its_producer.join();
+    ASSERT_EQ(0u, its_errors);
+    ASSERT_TRUE(is_empty());
+}
+
+#ifndef WIN32
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+#endif
@@ -0,0 +1,144 @@
+// Copyright (C) 2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <vsomeip/constants.hpp>
+
+#include "../implementation/endpoints/include/magic_cookie_scanner.hpp"
+
+namespace {
+
+const vsomeip::byte_t COOKIE_IDENTIFIER
+    = static_cast<vsomeip::byte_t>(vsomeip::MAGIC_COOKIE_CLIENT_MESSAGE);
+const vsomeip::byte_t COOKIE_TYPE
+    = static_cast<vsomeip::byte_t>(vsomeip::MAGIC_COOKIE_CLIENT_MESSAGE_TYPE);
+
+// Bytewise search as formerly done by endpoint_impl::find_magic_cookie
+uint32_t find_reference(const vsomeip::byte_t *_buffer, size_t _size) {
+    bool is_found(false);
+    uint32_t its_offset = 0xFFFFFFFF;
+    do {
+        its_offset++;
+        if (_size > its_offset + 16) {
+            is_found = (_buffer[its_offset] == 0xFF
+                     && _buffer[its_offset + 1] == 0xFF
+                     && _buffer[its_offset + 2] == COOKIE_IDENTIFIER
+                     && _buffer[its_offset + 3] == 0x00
+                     && _buffer[its_offset + 4] == 0x00
+                     && _buffer[its_offset + 5] == 0x00
+                     && _buffer[its_offset + 6] == 0x00
+                     && _buffer[its_offset + 7] == 0x08
+                     && _buffer[its_offset + 8] == 0xDE
+                     && _buffer[its_offset + 9] == 0xAD
+                     && _buffer[its_offset + 10] == 0xBE
+                     && _buffer[its_offset + 11] == 0xEF
+                     && _buffer[its_offset + 12] == 0x01
+                     && _buffer[its_offset + 13] == 0x01
+                     && _buffer[its_offset + 14] == COOKIE_TYPE
+                     && _buffer[its_offset + 15] == 0x00);
+        } else {
+            break;
+        }
+    } while (!is_found);
+    return (is_found ? its_offset : 0xFFFFFFFF);
+}
+
+uint32_t find_scanner(const vsomeip::byte_t *_buffer, size_t _size) {
+    return vsomeip::magic_cookie_scanner::find(_buffer, _size,
+            COOKIE_IDENTIFIER, COOKIE_TYPE);
+}
+
+// Fills the buffer with random data. Every 64th byte pair is set to 0xFFFF
+// so that the scanner has to verify candidates that are no cookies.
+void fill(std::vector<vsomeip::byte_t> &_buffer) {
+    for (size_t i = 0; i < _buffer.size(); ++i)
+        _buffer[i] = static_cast<vsomeip::byte_t>(std::rand());
+    for (size_t i = 0; i + 1 < _buffer.size(); i += 64)
+        _buffer[i] = _buffer[i + 1] = 0xFF;
+}
+
+void insert_cookie(std::vector<vsomeip::byte_t> &_buffer, size_t _offset) {
+    std::memcpy(&_buffer[_offset], vsomeip::CLIENT_COOKIE,
+            sizeof(vsomeip::CLIENT_COOKIE));
+}
+
+} // namespace
+
+TEST(magic_cookies_scan_benchmark, matches_reference)
+{
+    std::srand(0x5eed);
+    for (size_t its_size = 0; its_size < 300; ++its_size) {
+        std::vector<vsomeip::byte_t> its_buffer(its_size);
+        fill(its_buffer);
+        ASSERT_EQ(find_reference(its_buffer.data(), its_size),
+                find_scanner(its_buffer.data(), its_size));
+
+        for (size_t its_offset = 0; its_offset + 16 <= its_size; ++its_offset) {
+            fill(its_buffer);
+            insert_cookie(its_buffer, its_offset);
+            ASSERT_EQ(find_reference(its_buffer.data(), its_size),
+                    find_scanner(its_buffer.data(), its_size))
+                << "size " << its_size << " offset " << its_offset;
+        }
+    }
+}
+
+TEST(magic_cookies_scan_benchmark, ignores_service_cookie)
+{
+    std::vector<vsomeip::byte_t> its_buffer(64, 0);
+    std::memcpy(&its_buffer[8], vsomeip::SERVICE_COOKIE,
+            sizeof(vsomeip::SERVICE_COOKIE));
+    ASSERT_EQ(0xFFFFFFFF, find_scanner(its_buffer.data(), its_buffer.size()));
+}
+
+TEST(magic_cookies_scan_benchmark, compare_throughput)
+{
+    const size_t its_size = 64 * 1024;
+    const int its_runs = 200;
+
+    std::srand(0x5eed);
+    std::vector<vsomeip::byte_t> its_buffer(its_size);
+    fill(its_buffer);
+    insert_cookie(its_buffer, its_size - 32);
+
+    uint32_t its_reference_offset(0), its_scanner_offset(0);
+
+    std::chrono::steady_clock::time_point its_start
+        = std::chrono::steady_clock::now();
+    for (int i = 0; i < its_runs; ++i)
+        its_reference_offset += find_reference(its_buffer.data(), its_size);
+    std::chrono::steady_clock::duration its_reference
+        = std::chrono::steady_clock::now() - its_start;
+
+    its_start = std::chrono::steady_clock::now();
+    for (int i = 0; i < its_runs; ++i)
+        its_scanner_offset += find_scanner(its_buffer.data(), its_size);
+    std::chrono::steady_clock::duration its_scanner
+        = std::chrono::steady_clock::now() - its_start;
+
+    ASSERT_EQ(its_reference_offset, its_scanner_offset);
+
+    std::cout << "Scanned " << its_runs << " x " << its_size << " bytes: "
+            << "bytewise "
+            << std::chrono::duration_cast<std::chrono::microseconds>(
+                    its_reference).count() << "us, scanner "
+            << std::chrono::duration_cast<std::chrono::microseconds>(
+                    its_scanner).count() << "us" << std::endl;
+}
+
+#ifndef WIN32
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+#endif
@@ -0,0 +1,371 @@
+// Copyright (C) 2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <vsomeip/defines.hpp>
+
+#include "../implementation/service_discovery/include/defines.hpp"
+#include "../implementation/service_discovery/include/message_view.hpp"
+#include "../implementation/service_discovery/include/remote_offers.hpp"
+
+namespace {
+
+const vsomeip::service_t SERVICE = 0x1234;
+const vsomeip::instance_t INSTANCE = 0x5678;
+
+typedef std::vector<vsomeip::byte_t> bytes_t;
+
+void append_long(bytes_t &_data, std::uint32_t _value) {
+    _data.push_back(vsomeip::byte_t(_value >> 24));
+    _data.push_back(vsomeip::byte_t(_value >> 16));
+    _data.push_back(vsomeip::byte_t(_value >> 8));
+    _data.push_back(vsomeip::byte_t(_value));
+}
+
+bytes_t create_entry(vsomeip::sd::entry_type_e _type,
+        vsomeip::service_t _service, vsomeip::instance_t _instance,
+        vsomeip::ttl_t _ttl, vsomeip::byte_t _index, vsomeip::byte_t _num,
+        vsomeip::major_version_t _major = 1,
+        vsomeip::minor_version_t _minor = 0) {
+    bytes_t its_entry;
+    its_entry.push_back(vsomeip::byte_t(_type));
+    its_entry.push_back(_index);
+    its_entry.push_back(0);
+    its_entry.push_back(vsomeip::byte_t(_num << 4));
+    its_entry.push_back(vsomeip::byte_t(_service >> 8));
+    its_entry.push_back(vsomeip::byte_t(_service));
+    its_entry.push_back(vsomeip::byte_t(_instance >> 8));
+    its_entry.push_back(vsomeip::byte_t(_instance));
+    append_long(its_entry, (std::uint32_t(_major) << 24) | _ttl);
+    append_long(its_entry, _minor);
+    return its_entry;
+}
+
+bytes_t create_ipv4_option(vsomeip::byte_t _last_byte, std::uint16_t _port) {
+    bytes_t its_option = { 0x00, 0x09, 0x04, 0x00,
+            127, 0, 0, _last_byte,
+            0x00, 0x11, vsomeip::byte_t(_port >> 8), vsomeip::byte_t(_port) };
+    return its_option;
+}
+
+bytes_t create_message(const std::vector<bytes_t> &_entries,
+        const std::vector<bytes_t> &_options) {
+    bytes_t its_message = {
+            0xFF, 0xFF, 0x81, 0x00,     // service, method
+            0x00, 0x00, 0x00, 0x00,     // length
+            0x00, 0x00, 0x00, 0x01,     // client, session
+            0x01, 0x01, 0x02, 0x00,     // versions, type, return code
+            VSOMEIP_REBOOT_FLAG, 0x00, 0x00, 0x00 };
+
+    bytes_t its_entries;
+    for (auto &its_entry : _entries)
+        its_entries.insert(its_entries.end(), its_entry.begin(), its_entry.end());
+    append_long(its_message, std::uint32_t(its_entries.size()));
+    its_message.insert(its_message.end(), its_entries.begin(), its_entries.end());
+
+    bytes_t its_options;
+    for (auto &its_option : _options)
+        its_options.insert(its_options.end(), its_option.begin(), its_option.end());
+    append_long(its_message, std::uint32_t(its_options.size()));
+    its_message.insert(its_message.end(), its_options.begin(), its_options.end());
+
+    std::uint32_t its_length = std::uint32_t(its_message.size())
+            - VSOMEIP_SOMEIP_HEADER_SIZE;
+    its_message[VSOMEIP_LENGTH_POS_MAX - 1] = vsomeip::byte_t(its_length >> 8);
+    its_message[VSOMEIP_LENGTH_POS_MAX] = vsomeip::byte_t(its_length);
+    return its_message;
+}
+
+vsomeip::sd::message_view create_view(const bytes_t &_message) {
+    return vsomeip::sd::message_view(&_message[0],
+            vsomeip::length_t(_message.size()));
+}
+
+bytes_t create_offer(vsomeip::byte_t _last_byte, std::uint16_t _port,
+        vsomeip::minor_version_t _minor = 0) {
+    return create_message(
+            { create_entry(vsomeip::sd::entry_type_e::OFFER_SERVICE,
+                    SERVICE, INSTANCE, 3, 0, 1, 1, _minor) },
+            { create_ipv4_option(_last_byte, _port) });
+}
+
+} // namespace
+
+class message_view_test: public ::testing::Test
+{
+protected:
+    boost::asio::ip::address sender_
+        = boost::asio::ip::address::from_string("127.0.0.2");
+    boost::asio::ip::address other_sender_
+        = boost::asio::ip::address::from_string("127.0.0.3");
+};
+
+TEST_F(message_view_test, read_header_entries_and_options)
+{
+    bytes_t its_option = create_ipv4_option(2, 30509);
+    bytes_t its_message = create_message(
+            { create_entry(vsomeip::sd::entry_type_e::OFFER_SERVICE,
+                    SERVICE, INSTANCE, 3, 0, 1, 2, 7),
+              create_entry(vsomeip::sd::entry_type_e::FIND_SERVICE,
+                    0x4321, 0xFFFF, 0xFFFFFF, 0, 0) },
+            { its_option });
+    vsomeip::sd::message_view its_view = create_view(its_message);
+
+    ASSERT_TRUE(its_view.is_valid());
+    ASSERT_EQ(0x0001, its_view.get_session());
+    ASSERT_TRUE(its_view.get_reboot_flag());
+    ASSERT_EQ(0x01, its_view.get_protocol_version());
+    ASSERT_EQ(0x01, its_view.get_interface_version());
+    ASSERT_EQ(vsomeip::message_type_e::MT_NOTIFICATION,
+            its_view.get_message_type());
+    ASSERT_EQ(2u, its_view.get_num_entries());
+
+    vsomeip::sd::message_view::entry_view its_offer = its_view.get_entry(0);
+    ASSERT_EQ(vsomeip::sd::entry_type_e::OFFER_SERVICE, its_offer.get_type());
+    ASSERT_EQ(SERVICE, its_offer.get_service());
+    ASSERT_EQ(INSTANCE, its_offer.get_instance());
+    ASSERT_EQ(2, its_offer.get_major_version());
+    ASSERT_EQ(3u, its_offer.get_ttl());
+    ASSERT_EQ(7u, its_offer.get_minor_version());
+    ASSERT_EQ(0, its_offer.get_option_index(1));
+    ASSERT_EQ(1, its_offer.get_num_options(1));
+    ASSERT_EQ(0, its_offer.get_num_options(2));
+
+    vsomeip::sd::message_view::entry_view its_find = its_view.get_entry(1);
+    ASSERT_EQ(vsomeip::sd::entry_type_e::FIND_SERVICE, its_find.get_type());
+    ASSERT_EQ(0xFFFFFFu, its_find.get_ttl());
+
+    const vsomeip::byte_t *its_data(nullptr);
+    std::size_t its_size(0);
+    ASSERT_TRUE(its_view.get_option(0, its_data, its_size));
+    ASSERT_EQ(its_option.size(), its_size);
+    ASSERT_EQ(0, std::memcmp(&its_option[0], its_data, its_size));
+    ASSERT_FALSE(its_view.get_option(1, its_data, its_size));
+}
+
+TEST_F(message_view_test, accept_message_without_options)
+{
+    bytes_t its_message = create_message(
+            { create_entry(vsomeip::sd::entry_type_e::FIND_SERVICE,
+                    SERVICE, INSTANCE, 3, 0, 0) }, {});
+    ASSERT_TRUE(create_view(its_message).is_valid());
+
+    // The options array is optional
+    its_message.resize(its_message.size() - sizeof(std::uint32_t));
+    ASSERT_TRUE(create_view(its_message).is_valid());
+}
+
+TEST_F(message_view_test, reject_truncated_messages)
+{
+    bytes_t its_message = create_message(
+            { create_entry(vsomeip::sd::entry_type_e::OFFER_SERVICE,
+                    SERVICE, INSTANCE, 3, 0, 1) },
+            { create_ipv4_option(2, 30509) });
+    ASSERT_TRUE(create_view(its_message).is_valid());
+
+    // Truncated within the header, the entries, the length of the options
+    // array and the options
+    for (std::size_t its_size : { std::size_t(0), std::size_t(10),
+            std::size_t(VSOMEIP_SOMEIP_SD_ENTRIES_POS - 1),
+            std::size_t(VSOMEIP_SOMEIP_SD_ENTRIES_POS + 8),
+            std::size_t(VSOMEIP_SOMEIP_SD_ENTRIES_POS
+                    + VSOMEIP_SOMEIP_SD_ENTRY_SIZE + 2),
+            std::size_t(VSOMEIP_SOMEIP_SD_ENTRIES_POS
+                    + VSOMEIP_SOMEIP_SD_ENTRY_SIZE + 4 + 2),
+            its_message.size() - 1 }) {
+        bytes_t its_truncated(its_message.begin(),
+                its_message.begin() + its_size);
+        its_truncated.reserve(1);
+        vsomeip::sd::message_view its_view(its_truncated.data(),
+                vsomeip::length_t(its_truncated.size()));
+        ASSERT_FALSE(its_view.is_valid()) << "size " << its_size;
+    }
+}
+
+TEST_F(message_view_test, reject_inconsistent_lengths)
+{
+    bytes_t its_message = create_message(
+            { create_entry(vsomeip::sd::entry_type_e::OFFER_SERVICE,
+                    SERVICE, INSTANCE, 3, 0, 1) },
+            { create_ipv4_option(2, 30509) });
+
+    // Entries array that is no multiple of the entry size
+    bytes_t its_broken(its_message);
+    its_broken[VSOMEIP_SOMEIP_SD_ENTRIES_LENGTH_POS + 3] = 15;
+    ASSERT_FALSE(create_view(its_broken).is_valid());
+
+    // Entries array that exceeds the message
+    its_broken = its_message;
+    its_broken[VSOMEIP_SOMEIP_SD_ENTRIES_LENGTH_POS + 2] = 0x01;
+    ASSERT_FALSE(create_view(its_broken).is_valid());
+
+    // Option that exceeds the options array
+    const std::size_t its_options_pos = VSOMEIP_SOMEIP_SD_ENTRIES_POS
+            + VSOMEIP_SOMEIP_SD_ENTRY_SIZE + sizeof(std::uint32_t);
+    its_broken = its_message;
+    its_broken[its_options_pos + 1] = 0x0A;
+    ASSERT_FALSE(create_view(its_broken).is_valid());
+
+    // Options array that ends within an option
+    its_broken = its_message;
+    its_broken[its_options_pos - 1] = 0x04;
+    ASSERT_FALSE(create_view(its_broken).is_valid());
+
+    // Options array that exceeds the message
+    its_broken = its_message;
+    its_broken[its_options_pos - 2] = 0x01;
+    ASSERT_FALSE(create_view(its_broken).is_valid());
+}
+
+TEST_F(message_view_test, ignore_data_behind_the_options)
+{
+    bytes_t its_message = create_message(
+            { create_entry(vsomeip::sd::entry_type_e::OFFER_SERVICE,
+                    SERVICE, INSTANCE, 3, 0, 1) },
+            { create_ipv4_option(2, 30509) });
+    its_message.push_back(0x00);
+    its_message.push_back(0x01);
+
+    vsomeip::sd::message_view its_view = create_view(its_message);
+    ASSERT_TRUE(its_view.is_valid());
+
+    const vsomeip::byte_t *its_data(nullptr);
+    std::size_t its_size(0);
+    ASSERT_TRUE(its_view.get_option(0, its_data, its_size));
+    ASSERT_FALSE(its_view.get_option(1, its_data, its_size));
+}
+
+TEST_F(message_view_test, reject_out_of_range_option_index)
+{
+    bytes_t its_message = create_message(
+            { create_entry(vsomeip::sd::entry_type_e::OFFER_SERVICE,
+                    SERVICE, INSTANCE, 3, 1, 1) },
+            { create_ipv4_option(2, 30509) });
+    vsomeip::sd::message_view its_view = create_view(its_message);
+    ASSERT_TRUE(its_view.is_valid());
+
+    const vsomeip::byte_t *its_data(nullptr);
+    std::size_t its_size(0);
+    vsomeip::sd::message_view::entry_view its_entry = its_view.get_entry(0);
+    ASSERT_FALSE(its_view.get_option(its_entry.get_option_index(1),
+            its_data, its_size));
+
+    // Such offers are never refreshed without deserializing them
+    vsomeip::sd::remote_offers its_offers;
+    its_offers.update(its_view, sender_);
+    ASSERT_FALSE(its_offers.is_unchanged(its_view, sender_));
+}
+
+TEST_F(message_view_test, refresh_repeated_offers)
+{
+    vsomeip::sd::remote_offers its_offers;
+    bytes_t its_message = create_offer(2, 30509);
+    vsomeip::sd::message_view its_view = create_view(its_message);
+
+    ASSERT_FALSE(its_offers.is_unchanged(its_view, sender_));
+    its_offers.update(its_view, sender_);
+    ASSERT_TRUE(its_offers.is_unchanged(its_view, sender_));
+    ASSERT_FALSE(its_offers.is_unchanged(its_view, other_sender_));
+
+    // The TTL and the session are no part of the offer
+    bytes_t its_next(its_message);
+    its_next[VSOMEIP_SESSION_POS_MAX] = 0x02;
+    its_next[VSOMEIP_SOMEIP_SD_ENTRIES_POS + 11] = 0x05;
+    ASSERT_TRUE(its_offers.is_unchanged(create_view(its_next), sender_));
+
+    its_offers.remove(sender_);
+    ASSERT_FALSE(its_offers.is_unchanged(its_view, sender_));
+}
+
+TEST_F(message_view_test, fall_back_on_changed_offers)
+{
+    vsomeip::sd::remote_offers its_offers;
+    bytes_t its_message = create_offer(2, 30509);
+    its_offers.update(create_view(its_message), sender_);
+
+    // Changed endpoint options
+    bytes_t its_changed = create_offer(4, 30509);
+    ASSERT_FALSE(its_offers.is_unchanged(create_view(its_changed), sender_));
+    its_changed = create_offer(2, 30510);
+    ASSERT_FALSE(its_offers.is_unchanged(create_view(its_changed), sender_));
+
+    // Changed version
+    its_changed = create_offer(2, 30509, 1);
+    ASSERT_FALSE(its_offers.is_unchanged(create_view(its_changed), sender_));
+
+    // Additional option
+    its_changed = create_message(
+            { create_entry(vsomeip::sd::entry_type_e::OFFER_SERVICE,
+                    SERVICE, INSTANCE, 3, 0, 2) },
+            { create_ipv4_option(2, 30509), create_ipv4_option(2, 30510) });
+    ASSERT_FALSE(its_offers.is_unchanged(create_view(its_changed), sender_));
+
+    // Additional service
+    its_changed = create_message(
+            { create_entry(vsomeip::sd::entry_type_e::OFFER_SERVICE,
+                    SERVICE, INSTANCE, 3, 0, 1),
+              create_entry(vsomeip::sd::entry_type_e::OFFER_SERVICE,
+                    SERVICE, INSTANCE + 1, 3, 0, 1) },
+            { create_ipv4_option(2, 30509) });
+    ASSERT_FALSE(its_offers.is_unchanged(create_view(its_changed), sender_));
+
+    // The changed offer replaces the last one
+    its_changed = create_offer(4, 30509);
+    its_offers.update(create_view(its_changed), sender_);
+    ASSERT_TRUE(its_offers.is_unchanged(create_view(its_changed), sender_));
+    ASSERT_FALSE(its_offers.is_unchanged(create_view(its_message), sender_));
+}
+
+TEST_F(message_view_test, fall_back_on_other_entries)
+{
+    vsomeip::sd::remote_offers its_offers;
+    bytes_t its_message = create_offer(2, 30509);
+    its_offers.update(create_view(its_message), sender_);
+
+    // Stop offer
+    bytes_t its_other = create_message(
+            { create_entry(vsomeip::sd::entry_type_e::STOP_OFFER_SERVICE,
+                    SERVICE, INSTANCE, 0, 0, 1) },
+            { create_ipv4_option(2, 30509) });
+    ASSERT_FALSE(its_offers.is_unchanged(create_view(its_other), sender_));
+
+    // Find and eventgroup entries
+    its_other = create_message(
+            { create_entry(vsomeip::sd::entry_type_e::OFFER_SERVICE,
+                    SERVICE, INSTANCE, 3, 0, 1),
+              create_entry(vsomeip::sd::entry_type_e::FIND_SERVICE,
+                    SERVICE, INSTANCE, 3, 0, 0) },
+            { create_ipv4_option(2, 30509) });
+    ASSERT_FALSE(its_offers.is_unchanged(create_view(its_other), sender_));
+    its_other = create_message(
+            { create_entry(vsomeip::sd::entry_type_e::SUBSCRIBE_EVENTGROUP,
+                    SERVICE, INSTANCE, 3, 0, 1) },
+            { create_ipv4_option(2, 30509) });
+    ASSERT_FALSE(its_offers.is_unchanged(create_view(its_other), sender_));
+
+    // Messages without entries
+    its_other = create_message({}, {});
+    ASSERT_FALSE(its_offers.is_unchanged(create_view(its_other), sender_));
+
+    // A stop offer forgets the offer
+    its_other = create_message(
+            { create_entry(vsomeip::sd::entry_type_e::STOP_OFFER_SERVICE,
+                    SERVICE, INSTANCE, 0, 0, 1) },
+            { create_ipv4_option(2, 30509) });
+    its_offers.update(create_view(its_other), sender_);
+    ASSERT_FALSE(its_offers.is_unchanged(create_view(its_message), sender_));
+}
+
+#ifndef WIN32
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+#endif
@@ -0,0 +1,132 @@
+// Copyright (C) 2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../implementation/utility/include/timer_wheel.hpp"
+
+namespace {
+
+const std::chrono::milliseconds TICK(10);
+const std::size_t WHEEL_SIZE = 8;
+
+} // namespace
+
+class timer_wheel_test: public ::testing::Test
+{
+protected:
+    timer_wheel_test()
+        : wheel_(TICK, WHEEL_SIZE) {
+    }
+
+    // Advances the wheel by _ticks and returns the sorted expired keys
+    std::vector<int> advance(std::size_t _ticks) {
+        std::vector<int> its_expired;
+        for (std::size_t i = 0; i < _ticks; i++)
+            wheel_.advance(its_expired);
+        std::sort(its_expired.begin(), its_expired.end());
+        return its_expired;
+    }
+
+    vsomeip::timer_wheel<int> wheel_;
+};
+
+TEST_F(timer_wheel_test, expire_after_delay)
+{
+    ASSERT_TRUE(wheel_.empty());
+    wheel_.schedule(3, std::chrono::milliseconds(0));
+    ASSERT_FALSE(wheel_.empty());
+
+    // Delays are rounded up to ticks. Once the wheel runs, the current
+    // tick does not count.
+    wheel_.schedule(1, std::chrono::milliseconds(30));
+    wheel_.schedule(2, std::chrono::milliseconds(25));
+
+    ASSERT_EQ(std::vector<int>({ 3 }), advance(1));
+    ASSERT_EQ(std::vector<int>(), advance(2));
+    ASSERT_EQ(std::vector<int>({ 1, 2 }), advance(1));
+    ASSERT_TRUE(wheel_.empty());
+}
+
+TEST_F(timer_wheel_test, add_current_tick_while_running)
+{
+    wheel_.schedule(1, std::chrono::milliseconds(20));
+    ASSERT_EQ(std::vector<int>(), advance(1));
+
+    // Part of the current tick has already elapsed
+    wheel_.schedule(2, std::chrono::milliseconds(20));
+    ASSERT_EQ(std::vector<int>({ 1 }), advance(1));
+    ASSERT_EQ(std::vector<int>(), advance(1));
+    ASSERT_EQ(std::vector<int>({ 2 }), advance(1));
+    ASSERT_TRUE(wheel_.empty());
+
+    // The wheel stopped with the last expiry
+    wheel_.schedule(3, std::chrono::milliseconds(20));
+    ASSERT_EQ(std::vector<int>(), advance(1));
+    ASSERT_EQ(std::vector<int>({ 3 }), advance(1));
+}
+
+TEST_F(timer_wheel_test, keep_earlier_expiration)
+{
+    wheel_.schedule(1, std::chrono::milliseconds(50));
+    wheel_.schedule(1, std::chrono::milliseconds(100));
+    ASSERT_EQ(std::vector<int>({ 1 }), advance(5));
+    ASSERT_TRUE(wheel_.empty());
+
+    wheel_.schedule(2, std::chrono::milliseconds(100));
+    wheel_.schedule(2, std::chrono::milliseconds(50));
+    ASSERT_EQ(std::vector<int>(), advance(5));
+    ASSERT_EQ(std::vector<int>({ 2 }), advance(1));
+    ASSERT_TRUE(wheel_.empty());
+}
+
+TEST_F(timer_wheel_test, cancel)
+{
+    wheel_.schedule(1, std::chrono::milliseconds(20));
+    wheel_.schedule(2, std::chrono::milliseconds(20));
+    wheel_.cancel(1);
+    wheel_.cancel(3);
+    ASSERT_EQ(std::vector<int>({ 2 }), advance(3));
+    ASSERT_TRUE(wheel_.empty());
+
+    wheel_.schedule(1, std::chrono::milliseconds(20));
+    wheel_.cancel(1);
+    ASSERT_TRUE(wheel_.empty());
+    ASSERT_EQ(std::vector<int>(), advance(WHEEL_SIZE * 2));
+}
+
+TEST_F(timer_wheel_test, expire_across_revolutions)
+{
+    // Both keys share a slot, but expire in different revolutions
+    wheel_.schedule(2, TICK * 2);
+    wheel_.schedule(1, TICK * int(WHEEL_SIZE * 3 + 1));
+    ASSERT_EQ(std::vector<int>({ 2 }), advance(2));
+    ASSERT_EQ(std::vector<int>(), advance(WHEEL_SIZE * 3 - 1));
+    ASSERT_FALSE(wheel_.empty());
+    ASSERT_EQ(std::vector<int>({ 1 }), advance(1));
+    ASSERT_TRUE(wheel_.empty());
+}
+
+TEST_F(timer_wheel_test, cancel_across_revolutions)
+{
+    wheel_.schedule(1, TICK * int(WHEEL_SIZE * 2));
+    wheel_.schedule(2, TICK * int(WHEEL_SIZE * 2 + 1));
+    ASSERT_EQ(std::vector<int>(), advance(WHEEL_SIZE + 3));
+    wheel_.cancel(1);
+    ASSERT_EQ(std::vector<int>({ 2 }), advance(WHEEL_SIZE - 1));
+    ASSERT_TRUE(wheel_.empty());
+}
+
+#ifndef WIN32
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+#endif
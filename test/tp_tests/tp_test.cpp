@@ -0,0 +1,260 @@
+// Copyright (C) 2015 Bayerische Motoren Werke Aktiengesellschaft (BMW AG)
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <vsomeip/defines.hpp>
+
+#include "../implementation/configuration/include/internal.hpp"
+#include "../implementation/endpoints/include/tp.hpp"
+
+namespace {
+
+const vsomeip::service_t TP_SERVICE = 0x1234;
+const vsomeip::service_t OTHER_SERVICE = 0x4321;
+const std::uint32_t MAX_SEGMENT_LENGTH = 64;
+const std::uint32_t MAX_MESSAGE_SIZE = 1024;
+const std::uint32_t TIMEOUT = 1000;
+
+vsomeip::message_buffer_t create_message(vsomeip::service_t _service,
+        std::uint32_t _payload_size) {
+    vsomeip::message_buffer_t its_message(
+            VSOMEIP_PAYLOAD_POS + _payload_size);
+    std::uint32_t its_length = _payload_size + VSOMEIP_PAYLOAD_POS
+            - VSOMEIP_SOMEIP_HEADER_SIZE;
+    its_message[VSOMEIP_SERVICE_POS_MIN] = vsomeip::byte_t(_service >> 8);
+    its_message[VSOMEIP_SERVICE_POS_MAX] = vsomeip::byte_t(_service);
+    its_message[VSOMEIP_METHOD_POS_MIN] = 0x80;
+    its_message[VSOMEIP_METHOD_POS_MAX] = 0x01;
+    its_message[VSOMEIP_LENGTH_POS_MIN] = vsomeip::byte_t(its_length >> 24);
+    its_message[VSOMEIP_LENGTH_POS_MIN + 1] = vsomeip::byte_t(its_length >> 16);
+    its_message[VSOMEIP_LENGTH_POS_MIN + 2] = vsomeip::byte_t(its_length >> 8);
+    its_message[VSOMEIP_LENGTH_POS_MAX] = vsomeip::byte_t(its_length);
+    its_message[VSOMEIP_SESSION_POS_MAX] = 0x01;
+    its_message[VSOMEIP_PROTOCOL_VERSION_POS] = 0x01;
+    its_message[VSOMEIP_INTERFACE_VERSION_POS] = 0x01;
+    its_message[VSOMEIP_MESSAGE_TYPE_POS] = 0x02;
+    for (std::uint32_t i = 0; i < _payload_size; i++)
+        its_message[VSOMEIP_PAYLOAD_POS + i] = vsomeip::byte_t(i * 7 + 3);
+    return its_message;
+}
+
+// Builds a segment by hand, e.g. to create overlapping ones
+vsomeip::message_buffer_t create_segment(
+        const vsomeip::message_buffer_t &_message,
+        std::uint32_t _offset, std::uint32_t _length, bool _has_more) {
+    vsomeip::message_buffer_t its_segment(_message.begin(),
+            _message.begin() + VSOMEIP_PAYLOAD_POS);
+    its_segment[VSOMEIP_MESSAGE_TYPE_POS] |= VSOMEIP_TP_FLAG;
+    std::uint32_t its_header = (_offset | (_has_more ? 0x1 : 0x0));
+    its_segment.push_back(vsomeip::byte_t(its_header >> 24));
+    its_segment.push_back(vsomeip::byte_t(its_header >> 16));
+    its_segment.push_back(vsomeip::byte_t(its_header >> 8));
+    its_segment.push_back(vsomeip::byte_t(its_header));
+    its_segment.insert(its_segment.end(),
+            _message.begin() + VSOMEIP_PAYLOAD_POS + _offset,
+            _message.begin() + VSOMEIP_PAYLOAD_POS + _offset + _length);
+    return its_segment;
+}
+
+} // namespace
+
+class tp_test: public ::testing::Test
+{
+protected:
+    virtual void SetUp() {
+        tp_.set_policy(TP_SERVICE, MAX_SEGMENT_LENGTH, MAX_MESSAGE_SIZE,
+                TIMEOUT);
+    }
+
+    vsomeip::message_buffer_ptr_t reassemble(
+            const vsomeip::message_buffer_t &_segment) {
+        return tp_.reassemble(sender_, &_segment[0],
+                std::uint32_t(_segment.size()));
+    }
+
+    vsomeip::tp tp_;
+    vsomeip::tp::endpoint_type sender_ = vsomeip::tp::endpoint_type(
+            boost::asio::ip::address::from_string("127.0.0.1"), 30509);
+};
+
+TEST_F(tp_test, segment_only_configured_services)
+{
+    vsomeip::message_buffer_t its_message = create_message(OTHER_SERVICE, 200);
+    std::vector<vsomeip::message_buffer_ptr_t> its_segments;
+    ASSERT_FALSE(tp_.segment(&its_message[0], std::uint32_t(its_message.size()),
+            1400, its_segments));
+    ASSERT_TRUE(its_segments.empty());
+}
+
+TEST_F(tp_test, segment_and_reassemble)
+{
+    vsomeip::message_buffer_t its_message = create_message(TP_SERVICE, 200);
+    std::vector<vsomeip::message_buffer_ptr_t> its_segments;
+    ASSERT_TRUE(tp_.segment(&its_message[0], std::uint32_t(its_message.size()),
+            1400, its_segments));
+    ASSERT_EQ(4u, its_segments.size());
+
+    for (std::size_t i = 0; i < its_segments.size(); i++) {
+        const vsomeip::message_buffer_t &its_segment = *its_segments[i];
+        ASSERT_TRUE(vsomeip::tp::is_segment(&its_segment[0],
+                std::uint32_t(its_segment.size())));
+        ASSERT_LE(its_segment.size(), VSOMEIP_PAYLOAD_POS
+                + VSOMEIP_TP_HEADER_SIZE + MAX_SEGMENT_LENGTH);
+
+        vsomeip::message_buffer_ptr_t its_result = reassemble(its_segment);
+        if (i + 1 < its_segments.size()) {
+            ASSERT_FALSE(its_result);
+        } else {
+            ASSERT_TRUE(its_result);
+            ASSERT_EQ(its_message, *its_result);
+        }
+    }
+}
+
+TEST_F(tp_test, segment_respects_maximum_size)
+{
+    vsomeip::message_buffer_t its_message = create_message(TP_SERVICE, 200);
+    std::vector<vsomeip::message_buffer_ptr_t> its_segments;
+    ASSERT_TRUE(tp_.segment(&its_message[0], std::uint32_t(its_message.size()),
+            VSOMEIP_PAYLOAD_POS + VSOMEIP_TP_HEADER_SIZE + 40, its_segments));
+    ASSERT_EQ(7u, its_segments.size());
+    for (auto its_segment : its_segments)
+        ASSERT_LE(its_segment->size(),
+                VSOMEIP_PAYLOAD_POS + VSOMEIP_TP_HEADER_SIZE + 32u);
+}
+
+TEST_F(tp_test, reassemble_shuffled)
+{
+    vsomeip::message_buffer_t its_message = create_message(TP_SERVICE, 500);
+    std::vector<vsomeip::message_buffer_ptr_t> its_segments;
+    ASSERT_TRUE(tp_.segment(&its_message[0], std::uint32_t(its_message.size()),
+            1400, its_segments));
+
+    std::mt19937 its_generator(42);
+    for (int its_run = 0; its_run < 10; its_run++) {
+        std::shuffle(its_segments.begin(), its_segments.end(), its_generator);
+        vsomeip::message_buffer_ptr_t its_result;
+        for (std::size_t i = 0; i < its_segments.size(); i++) {
+            ASSERT_FALSE(its_result);
+            its_result = reassemble(*its_segments[i]);
+        }
+        ASSERT_TRUE(its_result);
+        ASSERT_EQ(its_message, *its_result);
+    }
+}
+
+TEST_F(tp_test, reassemble_ignores_duplicates)
+{
+    vsomeip::message_buffer_t its_message = create_message(TP_SERVICE, 100);
+    std::vector<vsomeip::message_buffer_ptr_t> its_segments;
+    ASSERT_TRUE(tp_.segment(&its_message[0], std::uint32_t(its_message.size()),
+            1400, its_segments));
+    ASSERT_EQ(2u, its_segments.size());
+
+    ASSERT_FALSE(reassemble(*its_segments[0]));
+    ASSERT_FALSE(reassemble(*its_segments[0]));
+    vsomeip::message_buffer_ptr_t its_result = reassemble(*its_segments[1]);
+    ASSERT_TRUE(its_result);
+    ASSERT_EQ(its_message, *its_result);
+}
+
+TEST_F(tp_test, reassemble_drops_overlapping_segments)
+{
+    vsomeip::message_buffer_t its_message = create_message(TP_SERVICE, 100);
+
+    ASSERT_FALSE(reassemble(create_segment(its_message, 0, 48, true)));
+    // Overlaps the end of the first segment
+    ASSERT_FALSE(reassemble(create_segment(its_message, 32, 32, true)));
+    // Overlaps the start of the first segment
+    ASSERT_FALSE(reassemble(create_segment(its_message, 0, 16, true)));
+    ASSERT_FALSE(reassemble(create_segment(its_message, 48, 32, true)));
+
+    vsomeip::message_buffer_ptr_t its_result
+        = reassemble(create_segment(its_message, 80, 20, false));
+    ASSERT_TRUE(its_result);
+    ASSERT_EQ(its_message, *its_result);
+}
+
+TEST_F(tp_test, reassemble_drops_segments_behind_the_last)
+{
+    vsomeip::message_buffer_t its_message = create_message(TP_SERVICE, 100);
+
+    ASSERT_FALSE(reassemble(create_segment(its_message, 64, 16, false)));
+    ASSERT_FALSE(reassemble(create_segment(its_message, 80, 16, true)));
+    ASSERT_FALSE(reassemble(create_segment(its_message, 0, 32, true)));
+
+    vsomeip::message_buffer_t its_expected(its_message.begin(),
+            its_message.begin() + VSOMEIP_PAYLOAD_POS + 80);
+    std::uint32_t its_length = 80 + VSOMEIP_PAYLOAD_POS
+            - VSOMEIP_SOMEIP_HEADER_SIZE;
+    its_expected[VSOMEIP_LENGTH_POS_MAX] = vsomeip::byte_t(its_length);
+
+    vsomeip::message_buffer_ptr_t its_result
+        = reassemble(create_segment(its_message, 32, 32, true));
+    ASSERT_TRUE(its_result);
+    ASSERT_EQ(its_expected, *its_result);
+}
+
+TEST_F(tp_test, reassemble_drops_misaligned_segments)
+{
+    vsomeip::message_buffer_t its_message = create_message(TP_SERVICE, 100);
+
+    // All segments but the last must carry a multiple of 16 bytes
+    ASSERT_FALSE(reassemble(create_segment(its_message, 0, 40, true)));
+    ASSERT_FALSE(reassemble(create_segment(its_message, 48, 52, false)));
+}
+
+TEST_F(tp_test, reassemble_drops_oversized_messages)
+{
+    vsomeip::message_buffer_t its_message
+        = create_message(TP_SERVICE, MAX_MESSAGE_SIZE + 64);
+
+    ASSERT_FALSE(reassemble(create_segment(its_message, 0, 64, true)));
+    ASSERT_FALSE(reassemble(create_segment(its_message,
+            MAX_MESSAGE_SIZE, 64, false)));
+
+    // The oversized segment dropped the pending message, so the message
+    // is incomplete until its first segment is received again
+    for (std::uint32_t its_offset = 64; its_offset < MAX_MESSAGE_SIZE;
+            its_offset += 64) {
+        ASSERT_FALSE(reassemble(create_segment(its_message, its_offset, 64,
+                its_offset + 64 < MAX_MESSAGE_SIZE)));
+    }
+
+    vsomeip::message_buffer_ptr_t its_result
+        = reassemble(create_segment(its_message, 0, 64, true));
+    ASSERT_TRUE(its_result);
+    ASSERT_EQ(VSOMEIP_PAYLOAD_POS + MAX_MESSAGE_SIZE, its_result->size());
+    ASSERT_TRUE(std::equal(its_result->begin() + VSOMEIP_PAYLOAD_POS,
+            its_result->end(), its_message.begin() + VSOMEIP_PAYLOAD_POS));
+}
+
+TEST_F(tp_test, reassemble_drops_unconfigured_services)
+{
+    vsomeip::message_buffer_t its_message = create_message(OTHER_SERVICE, 100);
+
+    ASSERT_FALSE(reassemble(create_segment(its_message, 0, 100, false)));
+}
+
+TEST_F(tp_test, reassemble_drops_segments_without_header)
+{
+    vsomeip::message_buffer_t its_message = create_message(TP_SERVICE, 2);
+    its_message[VSOMEIP_MESSAGE_TYPE_POS] |= VSOMEIP_TP_FLAG;
+
+    ASSERT_FALSE(reassemble(its_message));
+}
+
+#ifndef WIN32
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+#endif